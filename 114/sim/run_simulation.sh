@@ -0,0 +1,11 @@
+#!/bin/bash
+
+# 用法: ./run_simulation.sh [include_directory_path] [simulator options...]
+#   e.g. ./run_simulation.sh .. --present=rects
+# 不提供路径时使用本工程的 RTL 目录 (..)。构建选项 (NO_GL、THREADS、PROFILE、PLUGIN、
+# PIXEL_SINK、BUILD_ONLY) 见各工程共用的 harness/run_simulation.sh
+
+# 获取脚本所在的绝对路径
+SCRIPT_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+
+exec bash "$SCRIPT_DIR/../../harness/run_simulation.sh" "$SCRIPT_DIR" "${1:-$SCRIPT_DIR/..}" "${@:2}"
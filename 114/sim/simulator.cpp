@@ -0,0 +1,21 @@
+// 114 Breakout on the shared VGA/LED board simulator (../../harness).
+// Only this file and the Verilated model are compiled per project; the
+// harness and the Verilator runtime come prebuilt from build_harness.sh.
+// Run from this directory with the RTL one level up: ./run_simulation.sh ..
+#include "VDevelopmentBoard.h"            // from Verilating "DevelopmentBoard.v"
+#include "VDevelopmentBoard___024root.h"  // the public pixel_clk
+#include "vga_board.h"
+
+struct Breakout114Board {
+    typedef VDevelopmentBoard Model;
+    typedef Rgb565 PixelFormat;     // encoding of the rgb port
+
+    // syncGen runs on clk / 16 (clk_div, then counter num[0]), so pixels
+    // are sampled on the rising edges of that clock rather than every other
+    // board clock
+    static bool pixel_clock(const VDevelopmentBoard& m) {
+        return m.rootp->DevelopmentBoard__DOT__pixel_clk;
+    }
+};
+
+SIM_BOARD_MAIN(Breakout114Board)
@@ -33,5 +33,26 @@ module syncGen(clock, hsync, vsync, hcount, vcount, inDispArea);
         vblank <= vreset ? 0 : vblankon ? 1 : vblank;
         vsync <= vson ? 0 : vsoff ? 1 : vsync;
     end
+
+`ifdef VGA_PIXEL_SINK
+    // 仅用于仿真 (Verilator +define+VGA_PIXEL_SINK，见 harness/vga_board.h):
+    // 通过 DPI-C 报告这个时钟沿后计数器所在的有效像素，以及最后一个有效行结束 (连同有效区大小)
+    import "DPI-C" function void vga_sink_attach();
+    import "DPI-C" function void vga_sink_pixel(input int x, input int y);
+    import "DPI-C" function void vga_sink_frame(input int width, input int height);
+
+    wire [9:0] hcount_next, vcount_next;
+    assign hcount_next = hreset ? 0 : hcount + 1;
+    assign vcount_next = hreset ? (vreset ? 0 : vcount + 1) : vcount;
+
+    initial vga_sink_attach();
+
+    always @(posedge clock) begin
+        if((hcount_next < 640) & (vcount_next < 480))
+            vga_sink_pixel({22'd0, hcount_next}, {22'd0, vcount_next});
+        else if(vblankon)
+            vga_sink_frame(640, 480);
+    end
+`endif
 endmodule
 
@@ -14,10 +14,12 @@
  * Key Features:
  *  - Asynchronous active-low reset for full game state restoration
  *  - Active-low user inputs (compatible with physical development board buttons, debounce-free)
- *  - 32 bricks (4 rows × 8 columns) with individual active state tracking
+ *  - Parameterizable brick grid (default 4 rows × 8 columns = 32 bricks) with individual active state tracking
+ *  - Brick lookup per pixel tracked by grid cell counters that step with the pixel coordinates (no dividers, cost independent of brick count)
  *  - Win/loss condition detection and corresponding visual feedback
  *  - Ball paddle locking (before game start) for improved player aiming experience
  *  - VGA sync signal passthrough and 1-bit RGB color channel generation
+ *  - Single clock domain: pixel-rate logic advances on a clock enable from the counter (every second clock)
  * 
  * Port List (Detailed):
  *   - Input:  left    - Active low user input for paddle left movement.
@@ -44,10 +46,20 @@
  *                       start screen border, win screen flash) and game boundaries.
  *   - Output: endGame - Active high flag indicating game over (ball has hit the bottom border).
  *                       Remains high until asynchronous reset is triggered.
- *   - Output: winGame - Active high flag indicating game victory (all 32 bricks have been destroyed).
+ *   - Output: winGame - Active high flag indicating game victory (all bricks have been destroyed).
  *                       Triggers win screen animation and remains high until reset.
  */
-module breakout(
+module breakout #(
+    // Brick grid parameters (override for other layouts, e.g. 16 columns of narrower bricks × 8 rows)
+    parameter BRICK_COLS = 8,           // Number of brick columns
+    parameter BRICK_ROWS = 4,           // Number of brick rows
+    parameter BRICK_WIDTH = 60,         // Horizontal pixel width of each individual brick
+                                        // Chosen to fit 8 bricks across the game area with gaps
+    parameter BRICK_HEIGHT = 20,        // Vertical pixel height of each individual brick
+                                        // Balanced with brick width for visual proportionality
+    parameter BRICK_GAP = 5             // Horizontal/vertical pixel gap between adjacent bricks
+                                        // Prevents brick overlap and improves visual clarity
+)(
     input left,
     input right, 
     input fire1,
@@ -66,17 +78,23 @@ module breakout(
     // Parameter design principle: All constants are defined here for easy game tuning and maintenance
     // No hard-coded values in logic blocks to simplify future modifications (e.g., brick size, ball speed)
 
-    // Brick dimensions and positioning parameters (4 rows × 8 columns = 32 bricks total)
-    localparam BRICK_WIDTH = 60;        // Horizontal pixel width of each individual brick
-                                        // Chosen to fit 8 bricks across the game area with gaps
-    localparam BRICK_HEIGHT = 20;       // Vertical pixel height of each individual brick
-                                        // Balanced with brick width for visual proportionality
-    localparam BRICK_GAP = 5;           // Horizontal/vertical pixel gap between adjacent bricks
-                                        // Prevents brick overlap and improves visual clarity
+    // Brick grid positioning parameters (dimensions and grid size are module parameters)
     localparam BRICK_OFFSET_X = 10;     // Horizontal calibration offset for brick row alignment
                                         // Adjusts to center brick grid within game boundaries
     localparam BRICK_OFFSET_Y = -10;    // Vertical calibration offset for brick row alignment
                                         // Fine-tunes brick grid position to avoid top border overlap
+    localparam BRICK_COUNT = BRICK_COLS * BRICK_ROWS;               // Total number of bricks
+    localparam BRICK_INDEX_BITS = $clog2(BRICK_COUNT);              // Width of a brick index
+    localparam BRICK_COL_BITS = $clog2(BRICK_COLS + 1);             // Width of a column counter (BRICK_COLS = outside)
+    localparam BRICK_ROW_BITS = $clog2(BRICK_ROWS + 1);             // Width of a row counter (BRICK_ROWS = outside)
+    localparam BRICK_PITCH_X = BRICK_WIDTH + BRICK_GAP;             // Horizontal distance between brick columns
+    localparam BRICK_PITCH_Y = BRICK_HEIGHT + BRICK_GAP;            // Vertical distance between brick rows
+    localparam BRICK_OFF_X_BITS = $clog2(BRICK_PITCH_X);            // Width of the in-cell horizontal offset
+    localparam BRICK_OFF_Y_BITS = $clog2(BRICK_PITCH_Y);            // Width of the in-cell vertical offset
+    localparam BRICK_LEFT = 140+33 + BRICK_OFFSET_X - BRICK_WIDTH/2;// Left pixel column of the brick grid
+                                                                    // Calculation: first column center + calibration - half width
+    localparam BRICK_TOP = 35+30 + BRICK_OFFSET_Y - BRICK_HEIGHT/2; // Top pixel row of the brick grid
+                                                                    // Calculation: first row center + calibration - half height
     
     // Paddle (player-controlled) dimensions and movement parameters
     localparam PADDLE_WIDTH = 64;       // Horizontal pixel width of the paddle
@@ -128,7 +146,6 @@ module breakout(
 
     // ------------------------------ Internal Variable/Signal Declarations ------------------------------
     // Loop iteration variables (for brick array traversal and collision detection)
-    integer i, j, k;                    // i = total brick index (0-31), j = brick column index (0-7), k = brick row index (0-3)
     integer brickIndex = -1;            // Index of the brick hit by the ball (-1 = no brick collision detected)
                                         // Updated during collision detection, reset after brick destruction
 
@@ -148,15 +165,27 @@ module breakout(
     wire brickCollision;                // Active high when the ball collides with an active brick
                                         // Triggers brick destruction and ball vertical direction reversal
     wire[23:0] num;                     // 24-bit counter value from counter module (timing and animation control)
-                                        // Used for win screen flash animation and sub-clock logic triggering
+                                        // Used for win screen flash animation and the pixel clock enable
+    wire pixel_en;                      // Pixel clock enable: high on every second clock edge (num[0] = 0, where num[0] rises)
+                                        // Sync generator, brick rendering, collision detection and object updates advance on it
     wire[9:0] cX, cY, gX, gY;           // 10-bit VGA pixel coordinates (cX=horizontal, cY=vertical)
                                         // cX/cY = raw pixel counters from syncGen; gX/gY = aliases for graphics rendering
 
-    // Brick position registers (1-bit array flags for pixel-level brick rendering, 0-31 = 32 bricks)
-    reg brickX[0:31];                   // Horizontal pixel flag for each brick (1 = within brick horizontal range)
-                                        // Updated per pixel clock to mark brick horizontal boundaries
-    reg brickY[0:31];                   // Vertical pixel flag for each brick (1 = within brick vertical range)
-                                        // Updated per pixel clock to mark brick vertical boundaries
+    // Brick grid lookup counters (step with cX/cY, brick under the current pixel without dividers)
+    reg[BRICK_COL_BITS-1:0] brick_col = BRICK_COLS;
+                                        // Column of the grid cell under the current pixel (BRICK_COLS = outside the grid)
+    reg[BRICK_ROW_BITS-1:0] brick_row = BRICK_ROWS;
+                                        // Row of the grid cell under the current line (BRICK_ROWS = outside the grid)
+    reg[BRICK_OFF_X_BITS-1:0] brick_off_x = 0;
+                                        // Horizontal pixel offset within the current grid cell (0 to BRICK_PITCH_X-1)
+    reg[BRICK_OFF_Y_BITS-1:0] brick_off_y = 0;
+                                        // Vertical pixel offset within the current grid cell (0 to BRICK_PITCH_Y-1)
+    reg[BRICK_INDEX_BITS:0] brick_row_base = 0;
+                                        // Index of the first brick of the current row (brick_row * BRICK_COLS)
+    wire brick_in_grid;                 // Active high when the current pixel is within the brick grid
+    wire brick_in_cell;                 // Active high when the current pixel is on the brick of its cell (not the gap)
+    wire[BRICK_INDEX_BITS-1:0] brick_at;// Index of the brick under the current pixel (row * BRICK_COLS + column)
+    wire brick_here;                    // Active high when the current pixel is part of an active brick
     
     // Ball and paddle current position registers (10-bit for VGA 640x480 compatibility, non-blocking assignment)
     reg[9:0] ballPX = BALL_INIT_X;      // Current horizontal pixel position of the ball's center
@@ -175,21 +204,14 @@ module breakout(
                                         // Set high on fire1/fire2 press, low on reset
 
     // Brick status registers (array and composite flags for rendering and collision)
-    reg[3:0] bricks = 4'b0;             // Composite brick render flag (4 bits = 4 brick rows, 1 = row has active bricks)
-                                        // Simplifies collision detection by aggregating brick row status
-    reg[9:0] brickPX[0:7] = '{          // Initial horizontal center position of bricks (8 elements = 8 columns per row)
-        140+33+(BRICK_WIDTH+BRICK_GAP)*0 + BRICK_OFFSET_X, 140+33+(BRICK_WIDTH+BRICK_GAP)*1 + BRICK_OFFSET_X,
-        140+33+(BRICK_WIDTH+BRICK_GAP)*2 + BRICK_OFFSET_X, 140+33+(BRICK_WIDTH+BRICK_GAP)*3 + BRICK_OFFSET_X,
-        140+33+(BRICK_WIDTH+BRICK_GAP)*4 + BRICK_OFFSET_X, 140+33+(BRICK_WIDTH+BRICK_GAP)*5 + BRICK_OFFSET_X,
-        140+33+(BRICK_WIDTH+BRICK_GAP)*6 + BRICK_OFFSET_X, 140+33+(BRICK_WIDTH+BRICK_GAP)*7 + BRICK_OFFSET_X
-    };                                  // Calculation: base position + column offset + calibration
-    reg[9:0] brickPY[0:3] = '{          // Initial vertical center position of bricks (4 elements = 4 rows total)
-        35+30+25*0 + BRICK_OFFSET_Y, 35+30+25*1 + BRICK_OFFSET_Y,
-        35+30+25*2 + BRICK_OFFSET_Y, 35+30+25*3 + BRICK_OFFSET_Y
-    };                                  // Calculation: base position + row offset + calibration
-    reg[31:0] brickState = 32'hFFFFFFFF;// Brick active state register (32 bits = 32 bricks, 1 = active, 0 = destroyed)
+    reg[3:0] bricks = 4'b0;             // Composite brick render flag (4 bits = 4 brick colours, row k uses bit k % 4)
+                                        // Set for the active brick at the current pixel, used for rendering and collision
+    reg[BRICK_INDEX_BITS-1:0] bricks_at = {BRICK_INDEX_BITS{1'b0}};
+                                        // Index of the brick flagged in bricks (registered on the same pixel as bricks)
+    reg[BRICK_COUNT-1:0] brickState = {BRICK_COUNT{1'b1}};
+                                        // Brick active state register (1 bit per brick, 1 = active, 0 = destroyed)
                                         // Initialized to all 1's (all bricks active) - updated on brick collision
-    reg bricksRow = 1'b1;               // Flag for checking if the last brick row (row 3, indices 24-31) is destroyed
+    reg bricksRow = 1'b1;               // Flag for checking if the last brick row is destroyed
                                         // Used for internal game logic (future expansion: level progression)
     
     // Collision detection registers (1-bit flags for different collision types, reset per frame)
@@ -213,6 +235,15 @@ module breakout(
     reg[9:0] light_x = LEFT_BORDER;     // Horizontal pixel position of the win screen moving light bar
                                         // Animates from left to right across the screen post-victory
 
+    // Game state next-value signals (combinational, values after the current clock edge)
+    wire game_state_next;               // Game state after the current clock edge (start → run on left button press)
+    wire game_running;                  // Run state and not in reset (normal operation of the game state logic)
+    wire game_launch;                   // Active high when fire1/fire2 launches the ball on the current clock edge
+    wire game_started_next;             // Game start flag after the current clock edge
+    wire ball_dirX_next, ball_dirY_next;// Ball direction after the current clock edge (launch direction)
+    wire winGame_next;                  // Win flag after the current clock edge
+    wire[BRICK_COUNT-1:0] brickState_next;// Brick active state after the current clock edge (first brick restore)
+
     // Start screen graphics wires (combinational signals for start UI rendering)
     wire start_screen_border;           // Active high when current pixel is part of the start screen outer border
     wire start_screen_text;             // Active high when current pixel is part of the start screen text area
@@ -229,6 +260,27 @@ module breakout(
     assign start_screen_bg = inDispArea & (cX > LEFT_BORDER - 20 && cX < RIGHT_BORDER + 20) 
                             & (cY > TOP_BORDER - 20 && cY < BOTTOM_BORDER + 20) & ~start_screen_text & ~start_screen_border;
     
+    // ------------------------------ Game State Next Values (Combinational Logic) ------------------------------
+    /**
+     * Combinational Logic: Values of the game state registers after the current clock edge
+     * Function:
+     *  The pixel-rate logic runs on the same clock edge as the game state logic below, but must see the
+     *  values the game state logic assigns at that edge: as a num[0] sub-clock domain it used to run
+     *  after them. Reading these next values instead keeps the VGA output cycle-identical.
+     * 
+     * Key Notes:
+     *  - Fire1 and fire2 both launch the ball right and up (ball_dirX = 0, ball_dirY = 1)
+     *  - First brick restore: brick 0 comes back if it was incorrectly destroyed (no collision/frame reset)
+     */
+    assign game_state_next = (game_state == GAME_STATE_START && ~left) ? GAME_STATE_RUN : game_state;
+    assign game_running = (game_state == GAME_STATE_RUN) & rst_n;
+    assign game_launch = game_running & !game_started & !winGame & !endGame & (~fire1 | ~fire2);
+    assign game_started_next = game_started | game_launch;
+    assign ball_dirX_next = game_launch ? 1'b0 : ball_dirX;
+    assign ball_dirY_next = game_launch ? 1'b1 : ball_dirY;
+    assign winGame_next = winGame | (game_running & (brickState == 0) & !endGame);
+    assign brickState_next = {brickState[BRICK_COUNT-1:1], brickState[0] | (game_running & !brickCollision & !resetFrame)};
+    
     // ------------------------------ Game State Machine Logic (Sequential Logic) ------------------------------
     /**
      * Sequential Logic Block: Game State Control & Reset Handling
@@ -238,12 +290,13 @@ module breakout(
      *  2. Executes full asynchronous reset (restores all game objects/flags to initial values)
      *  3. Detects game victory (all bricks destroyed) and triggers win screen animation
      *  4. Handles game start (fire1/fire2) to unlock ball from paddle
-     *  5. Restores accidental first brick destruction (edge case handling)
      * 
      * Key Notes:
      *  - Asynchronous reset has highest priority (immediate response, no clock wait)
      *  - State transitions are one-way (start → run) unless reset is triggered
      *  - Win/loss flags remain high until reset (persistent status indication)
+     *  - Launch direction and first brick restore are registered by the object update block,
+     *    the only writer of ball_dirX/ball_dirY/brickState outside reset (see game_launch, brickState_next)
      */
     always @(posedge clock or negedge rst_n) begin
         // Game state: Start screen (idle, waiting for user input to enter run state)
@@ -280,22 +333,6 @@ module breakout(
                 // Reset brick collision index (no collision)
                 brickIndex <= -1;
                 
-                // Restore initial horizontal positions of all 8 brick columns
-                brickPX[0] <= 140+33+(BRICK_WIDTH+BRICK_GAP)*0 + BRICK_OFFSET_X;
-                brickPX[1] <= 140+33+(BRICK_WIDTH+BRICK_GAP)*1 + BRICK_OFFSET_X;
-                brickPX[2] <= 140+33+(BRICK_WIDTH+BRICK_GAP)*2 + BRICK_OFFSET_X;
-                brickPX[3] <= 140+33+(BRICK_WIDTH+BRICK_GAP)*3 + BRICK_OFFSET_X;
-                brickPX[4] <= 140+33+(BRICK_WIDTH+BRICK_GAP)*4 + BRICK_OFFSET_X;
-                brickPX[5] <= 140+33+(BRICK_WIDTH+BRICK_GAP)*5 + BRICK_OFFSET_X;
-                brickPX[6] <= 140+33+(BRICK_WIDTH+BRICK_GAP)*6 + BRICK_OFFSET_X;
-                brickPX[7] <= 140+33+(BRICK_WIDTH+BRICK_GAP)*7 + BRICK_OFFSET_X;
-                
-                // Restore initial vertical positions of all 4 brick rows
-                brickPY[0] <= 35+30+25*0 + BRICK_OFFSET_Y;
-                brickPY[1] <= 35+30+25*1 + BRICK_OFFSET_Y;
-                brickPY[2] <= 35+30+25*2 + BRICK_OFFSET_Y;
-                brickPY[3] <= 35+30+25*3 + BRICK_OFFSET_Y;
-                
                 // Restore initial ball direction (left/down)
                 ball_dirX <= BALL_INIT_DIR_X;
                 ball_dirY <= BALL_INIT_DIR_Y;
@@ -308,14 +345,9 @@ module breakout(
             end
             // Normal operation (no reset, game is running)
             else begin
-                // Edge case handling: Restore first brick if it was incorrectly destroyed (no collision/frame reset)
-                if(brickState[0] == 1'b0 && !brickCollision && !resetFrame) begin
-                    brickState[0] <= 1'b1;
-                end
-                
-                // Game victory detection: Set winGame high when all bricks are destroyed (brickState = 32'h0)
+                // Game victory detection: Set winGame high when all bricks are destroyed (brickState = 0)
                 // Only triggers if game is not already over (endGame = 0) to avoid conflicting status
-                if(brickState == 32'h0 && !endGame) begin
+                if(brickState == 0 && !endGame) begin
                     winGame <= 1'b1;
                 end
                 
@@ -336,80 +368,93 @@ module breakout(
                 
                 // Game start logic: Unlock ball from paddle when fire1 or fire2 is pressed (active low)
                 // Only effective if game is not started, not won, and not over (idle run state)
-                if(!game_started && !winGame && !endGame) begin
-                    // Fire1: Launch ball right and up (ball_dirX = 0, ball_dirY = 1)
-                    if(~fire1) begin
-                        game_started <= 1'b1;
-                        ball_dirX <= 1'b0;
-                        ball_dirY <= 1'b1;
-                    end
-                    // Fire2: Launch ball left and up (ball_dirX = 1, ball_dirY = 1)
-                    else if(~fire2) begin
-                        game_started <= 1'b1;
-                        ball_dirX <= 1'b0;
-                        ball_dirY <= 1'b1;
+                if(game_launch) begin
+                    game_started <= 1'b1;
+                end
+            end
+        end
+    end
+    
+    // ------------------------------ Brick Grid Lookup (Sequential Logic) ------------------------------
+    /**
+     * Sequential Logic Block: Brick Grid Cell Counters
+     * Trigger: Positive edge of clock with pixel clock enable (pixel_en, same edges as the sync generator)
+     * Function:
+     *  1. Once per line, on the pixel just left of the grid (cX = BRICK_LEFT-1): restarts the column count and
+     *     steps the row count for the line that is being scanned (restarts it on the first grid line, cY = BRICK_TOP)
+     *  2. On every other pixel within the grid: steps the in-cell offset and wraps it into the next column at the pitch
+     *  3. Columns and rows saturate at BRICK_COLS/BRICK_ROWS, marking pixels right of or below the grid
+     * 
+     * Key Notes:
+     *  - Replaces a division/remainder of cX/cY by the pitch: only small counters and comparators per pixel
+     *  - cX advances by one per pixel enable across the grid and cY by one per line, so the counters always
+     *    describe the cell under the current pixel once the edge has settled
+     *  - Free running (no reset): the counters re-synchronise on the next line and frame by themselves
+     */
+    always @(posedge clock) begin
+        if(pixel_en) begin
+            if(cX == BRICK_LEFT - 1) begin
+                // Next pixel is the left edge of the grid: first column of this line
+                brick_col <= 0;
+                brick_off_x <= 0;
+                // Row of this line: restart on the first grid line, then step once per line until past the grid
+                if(cY == BRICK_TOP) begin
+                    brick_row <= 0;
+                    brick_off_y <= 0;
+                    brick_row_base <= 0;
+                end else if(brick_row < BRICK_ROWS) begin
+                    if(brick_off_y == BRICK_PITCH_Y - 1) begin
+                        brick_row <= brick_row + 1;
+                        brick_off_y <= 0;
+                        brick_row_base <= brick_row_base + BRICK_COLS;
+                    end else begin
+                        brick_off_y <= brick_off_y + 1;
                     end
                 end
+            end else if(brick_col < BRICK_COLS) begin
+                // Within the grid: step the in-cell offset, wrap into the next column at the pitch
+                if(brick_off_x == BRICK_PITCH_X - 1) begin
+                    brick_col <= brick_col + 1;
+                    brick_off_x <= 0;
+                end else begin
+                    brick_off_x <= brick_off_x + 1;
+                end
             end
         end
     end
+
+    // Brick under the current pixel: inside the grid, on the brick of its cell (not the gap), and still active
+    assign brick_in_grid = (brick_col < BRICK_COLS) & (brick_row < BRICK_ROWS);
+    assign brick_in_cell = (brick_off_x < BRICK_WIDTH) & (brick_off_y < BRICK_HEIGHT);
+    assign brick_at = brick_row_base + brick_col;
+    assign brick_here = brick_in_grid & brick_in_cell & brickState_next[brick_at];
     
     // ------------------------------ Brick Rendering Logic (Sequential Logic) ------------------------------
     /**
      * Sequential Logic Block: Brick Graphics Generation & Row Status Check
-     * Trigger: Positive edge of num[0] (sub-clock, derived from 24-bit counter - reduces logic load)
+     * Trigger: Positive edge of clock with pixel clock enable (pixel_en, every second clock - reduces logic load)
      * Function:
-     *  1. Checks if the last brick row (row 3, indices 24-31) is destroyed (bricksRow flag)
-     *  2. Traverses all 32 bricks (4 rows × 8 columns) to set horizontal/vertical pixel flags (brickX/brickY)
-     *  3. Generates composite brick row flags (bricks[0:3]) for simplified collision detection
-     *  4. Only renders active bricks (brickState[i] = 1) to avoid drawing destroyed bricks
+     *  1. Checks if the last brick row is destroyed (bricksRow flag)
+     *  2. Sets the composite brick flag (bricks[0:3]) of the active brick at the current pixel (brick grid lookup) and registers its index (bricks_at)
+     *  3. Only renders active bricks (brickState[i] = 1) to avoid drawing destroyed bricks
      * 
      * Key Notes:
-     *  - Uses two rendering logics for bricks 0/1 (interval check) and others (edge check) for efficiency
-     *  - Composite bricks flag aggregates row status to reduce downstream collision logic complexity
+     *  - Brick rows cycle through the 4 bits of bricks, which select the brick colour
+     *  - bricks is registered (non-blocking): collision detection reads it through brickCollision/bouncingObject
+     *    on the next pixel, as it did when bricks was assigned blocking on num[0] (those wires were settled after
+     *    the num[0] blocks ran, so the collision blocks saw the bricks of the previous pixel)
      *  - Only executes in run state (no brick rendering on start screen)
+     *  - Reads the next values of the game state registers (same clock edge as the game state logic)
      */
-    always @(posedge num[0]) begin
-        // Only execute brick rendering if game is in run state
-        if(game_state == GAME_STATE_RUN) begin
-            // Reset composite brick row flag to 0 (rebuild per sub-clock cycle)
-            bricks = 4'b0;
-            // Check if last brick row (indices 24-31) is destroyed: AND of ~brickState[i] for all row 3 bricks
-            // bricksRow = 1 only if all row 3 bricks are destroyed (~brickState[i] = 1 for all i=24-31)
-            for(i=24; i<32; i=i+1)
-                bricksRow = bricksRow & ~brickState[i];
-            
-            // Traverse all 32 bricks (0-31) to set pixel flags and composite row flags
-            for(i=0; i<32; i=i+1) begin
-                // Calculate column index (j = 0-7) and row index (k = 0-3) from total brick index (i)
-                j = i % 8;    // Column index (mod 8 to wrap every 8 bricks)
-                k = i / 8;    // Row index (integer division by 8 to get row number)
-                
-                // Only process active bricks (brickState[i] = 1 - not destroyed)
-                if(brickState[i]) begin
-                    // Brick rendering logic for first two bricks (0/1): Interval check for full pixel range
-                    // More efficient for early bricks, avoids redundant edge checks
-                    if(i == 0 || i == 1) begin
-                        brickX[i] = (cX >= brickPX[j] - BRICK_WIDTH/2) && (cX <= brickPX[j] + BRICK_WIDTH/2 - 1) ? 1'b1 : 1'b0;
-                        brickY[i] = (cY >= brickPY[k] - BRICK_HEIGHT/2) && (cY <= brickPY[k] + BRICK_HEIGHT/2 - 1) ? 1'b1 : 1'b0;
-                    end 
-                    // Brick rendering logic for all other bricks (2-31): Edge check with state retention
-                    // More efficient for large brick arrays, only updates on edge crossing
-                    else begin
-                        brickX[i] = (cX == brickPX[j] - BRICK_WIDTH/2) ? 1 : (cX == brickPX[j] + BRICK_WIDTH/2 - 1) ? 0 : brickX[i];
-                        brickY[i] = (cY == brickPY[k] - BRICK_HEIGHT/2) ? 1 : (cY == brickPY[k] + BRICK_HEIGHT/2 - 1) ? 0 : brickY[i];
-                    end
-                    
-                    // Set composite brick row flag (bricks[k]) by OR-ing brickX[i] & brickY[i] for all bricks in row k
-                    // bricks[k] = 1 if any brick in row k is active and visible at current pixel
-                    case(k)
-                        0: bricks[0] |= brickX[i] & brickY[i];
-                        1: bricks[1] |= brickX[i] & brickY[i];
-                        2: bricks[2] |= brickX[i] & brickY[i];
-                        3: bricks[3] |= brickX[i] & brickY[i];
-                    endcase
-                end
-            end
+    always @(posedge clock) begin
+        // Only execute brick rendering on the pixel clock enable and if game is in run state
+        if(pixel_en && game_state_next == GAME_STATE_RUN) begin
+            // Check if last brick row is destroyed: NOR of its brickState bits (sticky until reset)
+            bricksRow <= bricksRow & ~|brickState_next[BRICK_COUNT-1 -: BRICK_COLS];
+            // Set the brick colour flag of the current pixel's row if it is part of an active brick
+            bricks <= brick_here ? 4'b1 << (brick_row % 4) : 4'b0;
+            // Register the index of that brick alongside, so collisions see the brick that bricks flags
+            bricks_at <= brick_at;
         end
     end
     
@@ -417,16 +462,18 @@ module breakout(
     // Instantiate 24-bit counter module for timing control (animation, sub-clock logic)
     // Connects system clock to counter input, 24-bit output to internal num wire
     counter c(.clock(clock), .out(num));
+    // Pixel clock enable: the edges where num[0] rises, i.e. half the system clock rate
+    assign pixel_en = ~num[0];
     
     // Instantiate VGA sync signal generator module for pixel timing and display area detection
-    // Connects sub-clock (num[0]) to syncGen clock, outputs hsync/vsync and pixel coordinates
-    syncGen generator(.clock(num[0]), .hsync(hsync), .vsync(vsync), 
+    // Connects system clock and pixel clock enable to syncGen, outputs hsync/vsync and pixel coordinates
+    syncGen generator(.clock(clock), .enable(pixel_en), .hsync(hsync), .vsync(vsync), 
                      .hcount(cX), .vcount(cY), .inDispArea(inDispArea));
     
     // ------------------------------ Boundary Collision Detection (Horizontal/Top) (Sequential Logic) ------------------------------
     /**
      * Sequential Logic Block: Ball vs Left/Right/Top Border Collision Detection
-     * Trigger: Positive edge of num[0] (sub-clock) OR negative edge of rst_n (asynchronous reset)
+     * Trigger: Positive edge of clock with pixel clock enable (pixel_en) OR negative edge of rst_n (asynchronous reset)
      * Function:
      *  1. Detects ball collisions with left (LEFT_BORDER), right (RIGHT_BORDER), and top (TOP_BORDER) boundaries
      *  2. Sets corresponding collision flags (collisionX1/collisionX2/collisionY1) when collision occurs
@@ -439,30 +486,33 @@ module breakout(
      *  - Ball position is within boundary threshold (e.g., ballPX - BALL_HALF_WIDTH <= LEFT_BORDER)
      *  - Current pixel coordinate matches ball position (cY == ballPY for horizontal, cX == ballPX for vertical)
      */
-    always @(posedge num[0] or negedge rst_n) begin
+    always @(posedge clock or negedge rst_n) begin
         // Only execute boundary collision detection if game is in run state
-        if(game_state == GAME_STATE_RUN) begin
+        if(game_state_next == GAME_STATE_RUN) begin
             // Asynchronous reset: Reset all boundary collision flags to inactive (low)
             if(!rst_n) begin
                 collisionX1 <= 1'b0; collisionX2 <= 1'b0; collisionY1 <= 1'b0;
             end 
-            // Reset collision flags at the end of each frame (avoid cross-frame residual triggers)
-            else if(resetFrame) begin
-                collisionX1 <= 1'b0; collisionX2 <= 1'b0; collisionY1 <= 1'b0;
-            end 
-            // Normal operation: Detect collisions and set flags
-            else begin
-                // Left border collision detection: Ball's left edge hits LEFT_BORDER
-                if(game_started && bouncingObject & (ballPX - BALL_HALF_WIDTH <= LEFT_BORDER) & (cY == ballPY))
-                    collisionX1 <= 1'b1;
+            // Pixel-rate operation: Only on clock edges where the pixel clock enable is high
+            else if(pixel_en) begin
+                // Reset collision flags at the end of each frame (avoid cross-frame residual triggers)
+                if(resetFrame) begin
+                    collisionX1 <= 1'b0; collisionX2 <= 1'b0; collisionY1 <= 1'b0;
+                end 
+                // Normal operation: Detect collisions and set flags
+                else begin
+                    // Left border collision detection: Ball's left edge hits LEFT_BORDER
+                    if(game_started_next && bouncingObject & (ballPX - BALL_HALF_WIDTH <= LEFT_BORDER) & (cY == ballPY))
+                        collisionX1 <= 1'b1;
 
-                // Right border collision detection: Ball's right edge hits RIGHT_BORDER
-                if(game_started && bouncingObject & (ballPX + BALL_HALF_WIDTH >= RIGHT_BORDER) & (cY == ballPY))
-                    collisionX2 <= 1'b1;
+                    // Right border collision detection: Ball's right edge hits RIGHT_BORDER
+                    if(game_started_next && bouncingObject & (ballPX + BALL_HALF_WIDTH >= RIGHT_BORDER) & (cY == ballPY))
+                        collisionX2 <= 1'b1;
 
-                // Top border collision detection: Ball's top edge hits TOP_BORDER
-                if(game_started && bouncingObject & (ballPY - BALL_HALF_HEIGHT <= TOP_BORDER) & (cX == ballPX))
-                    collisionY1 <= 1'b1;
+                    // Top border collision detection: Ball's top edge hits TOP_BORDER
+                    if(game_started_next && bouncingObject & (ballPY - BALL_HALF_HEIGHT <= TOP_BORDER) & (cX == ballPX))
+                        collisionY1 <= 1'b1;
+                end
             end
         end
     end
@@ -470,7 +520,7 @@ module breakout(
     // ------------------------------ Paddle Collision Detection (Sequential Logic) ------------------------------
     /**
      * Sequential Logic Block: Ball vs Paddle Collision Detection
-     * Trigger: Positive edge of num[0] (sub-clock) OR negative edge of rst_n (asynchronous reset)
+     * Trigger: Positive edge of clock with pixel clock enable (pixel_en) OR negative edge of rst_n (asynchronous reset)
      * Function:
      *  1. Detects ball collisions with the player's paddle (only when ball is moving downward)
      *  2. Sets collisionPaddle flag when ball is within paddle's horizontal/vertical boundaries
@@ -484,25 +534,28 @@ module breakout(
      *  - Ball's vertical range overlaps with paddle's vertical range
      *  - Ball's horizontal range overlaps with paddle's horizontal range
      */
-    always @(posedge num[0] or negedge rst_n) begin
+    always @(posedge clock or negedge rst_n) begin
         // Only execute paddle collision detection if game is in run state
-        if(game_state == GAME_STATE_RUN) begin
+        if(game_state_next == GAME_STATE_RUN) begin
             // Asynchronous reset: Reset paddle collision flag to inactive (low)
             if(!rst_n) begin
                 collisionPaddle <= 1'b0;
             end 
-            // Reset paddle collision flag at the end of each frame (avoid cross-frame residual triggers)
-            else if(resetFrame) begin
-                collisionPaddle <= 1'b0;
-            end 
-            // Normal operation: Detect ball-paddle collision and set flag
-            else if(game_started && bouncingObject & (ball_dirY == 1'b0) & 
-                       (ballPY + BALL_HALF_HEIGHT >= paddlePY - PADDLE_HEIGHT/2) &
-                       (ballPY - BALL_HALF_HEIGHT <= paddlePY + PADDLE_HEIGHT/2) & 
-                       (ballPX + BALL_HALF_WIDTH >= paddlePX - PADDLE_WIDTH/2) & 
-                       (ballPX - BALL_HALF_WIDTH <= paddlePX + PADDLE_WIDTH/2)) begin
-                // Collision detected: Ball is within paddle's horizontal and vertical boundaries (moving downward)
-                collisionPaddle <= 1'b1;
+            // Pixel-rate operation: Only on clock edges where the pixel clock enable is high
+            else if(pixel_en) begin
+                // Reset paddle collision flag at the end of each frame (avoid cross-frame residual triggers)
+                if(resetFrame) begin
+                    collisionPaddle <= 1'b0;
+                end 
+                // Normal operation: Detect ball-paddle collision and set flag
+                else if(game_started_next && bouncingObject & (ball_dirY_next == 1'b0) & 
+                           (ballPY + BALL_HALF_HEIGHT >= paddlePY - PADDLE_HEIGHT/2) &
+                           (ballPY - BALL_HALF_HEIGHT <= paddlePY + PADDLE_HEIGHT/2) & 
+                           (ballPX + BALL_HALF_WIDTH >= paddlePX - PADDLE_WIDTH/2) & 
+                           (ballPX - BALL_HALF_WIDTH <= paddlePX + PADDLE_WIDTH/2)) begin
+                    // Collision detected: Ball is within paddle's horizontal and vertical boundaries (moving downward)
+                    collisionPaddle <= 1'b1;
+                end
             end
         end
     end
@@ -510,7 +563,7 @@ module breakout(
     // ------------------------------ Bottom Border Collision (Game Over) (Sequential Logic) ------------------------------
     /**
      * Sequential Logic Block: Ball vs Bottom Border Collision Detection (Game Over Trigger)
-     * Trigger: Positive edge of num[0] (sub-clock) OR negative edge of rst_n (asynchronous reset)
+     * Trigger: Positive edge of clock with pixel clock enable (pixel_en) OR negative edge of rst_n (asynchronous reset)
      * Function:
      *  1. Detects ball collisions with the bottom border (BOTTOM_BORDER - game over condition)
      *  2. Sets collisionBottom flag when ball's bottom edge hits the bottom border
@@ -522,21 +575,24 @@ module breakout(
      *  - Bottom border collision is the only boundary collision that triggers game over (no ball bounce)
      *  - Collision condition matches other boundary checks for consistency
      */
-    always @(posedge num[0] or negedge rst_n) begin
+    always @(posedge clock or negedge rst_n) begin
         // Only execute bottom border collision detection if game is in run state
-        if(game_state == GAME_STATE_RUN) begin
+        if(game_state_next == GAME_STATE_RUN) begin
             // Asynchronous reset: Reset bottom border collision flag to inactive (low)
             if(!rst_n) begin
                 collisionBottom <= 1'b0;
             end 
-            // Reset bottom border collision flag at the end of each frame (avoid cross-frame residual triggers)
-            else if(resetFrame) begin
-                collisionBottom <= 1'b0;
-            end 
-            // Normal operation: Detect bottom border collision and set flag (game over imminent)
-            else begin
-                if(game_started && bouncingObject & (ballPY + BALL_HALF_HEIGHT >= BOTTOM_BORDER) & (cX == ballPX)) begin
-                    collisionBottom <= 1'b1;
+            // Pixel-rate operation: Only on clock edges where the pixel clock enable is high
+            else if(pixel_en) begin
+                // Reset bottom border collision flag at the end of each frame (avoid cross-frame residual triggers)
+                if(resetFrame) begin
+                    collisionBottom <= 1'b0;
+                end 
+                // Normal operation: Detect bottom border collision and set flag (game over imminent)
+                else begin
+                    if(game_started_next && bouncingObject & (ballPY + BALL_HALF_HEIGHT >= BOTTOM_BORDER) & (cX == ballPX)) begin
+                        collisionBottom <= 1'b1;
+                    end
                 end
             end
         end
@@ -545,7 +601,7 @@ module breakout(
     // ------------------------------ Object Movement and Collision Response (Sequential Logic) ------------------------------
     /**
      * Sequential Logic Block: Game Object Update (Ball/Paddle/Bricks) & Collision Response
-     * Trigger: Positive edge of num[0] (sub-clock) OR negative edge of rst_n (asynchronous reset)
+     * Trigger: Positive edge of clock with pixel clock enable (pixel_en) OR negative edge of rst_n (asynchronous reset)
      * Function:
      *  1. Identifies the hit brick index (brickIndex) when brick collision is detected
      *  2. Destroys hit bricks (sets brickState[brickIndex] = 0) and reverses ball vertical direction
@@ -558,89 +614,95 @@ module breakout(
      *  - All object updates occur at the end of the frame (resetFrame) for frame synchronization
      *  - Collision responses (direction reversal, position correction) are applied immediately after collision detection
      *  - Paddle movement is boundary-constrained to prevent exiting the game area
+     *  - Only writer of ball_dirX/ball_dirY/brickState outside reset, so pixel-rate updates take priority
+     *    over the launch direction and first brick restore of the same clock edge
      */
-    always @(posedge num[0] or negedge rst_n) begin
+    always @(posedge clock or negedge rst_n) begin
         // Only execute object updates if game is in run state
-        if(game_state == GAME_STATE_RUN) begin
+        if(game_state_next == GAME_STATE_RUN) begin
             // Asynchronous reset: Reset brick collision index to -1 (no collision)
             if(!rst_n) begin
                 brickIndex <= -1;
             end 
             // Normal operation: Identify hit brick and update objects
             else begin
-                // Identify hit brick index: Traverse all 32 bricks when brickCollision is detected
-                if(brickCollision) begin
-                    brickIndex <= -1; // Reset index first to avoid residual values
-                    for(i=0; i<32; i=i+1) begin
-                        if(brickX[i] & brickY[i]) begin // Brick is active and colliding with ball
-                            brickIndex <= i; // Store hit brick index
-                            break; // Exit loop early (only one brick can be hit per frame)
-                        end
-                    end
-                end
+                // Register the game state logic's updates of the shared registers on every clock:
+                // first brick restore and ball launch direction (overridden below on pixel-rate updates)
+                brickState[0] <= brickState_next[0];
+                ball_dirX <= ball_dirX_next;
+                ball_dirY <= ball_dirY_next;
                 
-                // Object update phase: Execute at the end of each frame (resetFrame) for synchronization
-                if(resetFrame) begin
-                    // Brick destruction & ball vertical direction reversal (collision response)
-                    // Only execute if game is started and valid brick index is detected (0-31)
-                    if(game_started && brickIndex >= 0 && brickIndex < 32) begin
-                        brickState[brickIndex] <= 1'b0; // Mark brick as destroyed (inactive)
-                        ball_dirY <= ~ball_dirY; // Reverse ball vertical direction (bounce)
-                        brickIndex <= -1; // Reset brick index (no active collision)
+                // Pixel-rate operation: Only on clock edges where the pixel clock enable is high
+                if(pixel_en) begin
+                    // Identify hit brick index: The brick flagged in bricks when brickCollision is detected
+                    // (bricks_at is registered on the same pixel as bricks, so it is always a valid index here)
+                    if(brickCollision) begin
+                        brickIndex <= bricks_at;
                     end
-                    
-                    // Pre-game start: Paddle movement (user input) with ball locked to paddle
-                    // Ball follows paddle horizontally, vertical position fixed to initial value
-                    if(!game_started && !winGame && !endGame) begin
-                        // Paddle left movement: Only if left button is pressed and paddle is within left boundary
-                        if(~left && (paddlePX - PADDLE_WIDTH/2 > LEFT_BORDER)) begin
-                            paddlePX <= paddlePX - PADDLE_SPEED; // Move paddle left
-                            ballPX <= paddlePX - PADDLE_SPEED;   // Lock ball to paddle (left movement)
-                        end
-                        // Paddle right movement: Only if right button is pressed and paddle is within right boundary
-                        else if(~right && (paddlePX + PADDLE_WIDTH/2 < RIGHT_BORDER)) begin
-                            paddlePX <= paddlePX + PADDLE_SPEED; // Move paddle right
-                            ballPX <= paddlePX + PADDLE_SPEED;   // Lock ball to paddle (right movement)
+                
+                    // Object update phase: Execute at the end of each frame (resetFrame) for synchronization
+                    if(resetFrame) begin
+                        // Brick destruction & ball vertical direction reversal (collision response)
+                        // Only execute if game is started and valid brick index is detected (0 to BRICK_COUNT-1)
+                        if(game_started_next && brickIndex >= 0 && brickIndex < BRICK_COUNT) begin
+                            brickState[brickIndex] <= 1'b0; // Mark brick as destroyed (inactive)
+                            ball_dirY <= ~ball_dirY_next; // Reverse ball vertical direction (bounce)
+                            brickIndex <= -1; // Reset brick index (no active collision)
                         end
-                        // Fix ball vertical position to initial value (pre-game start)
-                        ballPY <= BALL_INIT_Y;
-                    end
                     
-                    // Post-game start: Active ball/paddle movement & collision response (non-win/loss)
-                    else if(game_started && !winGame && !endGame) begin
-                        // Ball horizontal position & direction update (border collision response)
-                        if(collisionX1) begin // Left border collision: Reverse to right direction
-                            ball_dirX <= 1'b0;
-                            ballPX <= LEFT_BORDER + BALL_HALF_WIDTH + BALL_SPEED_X; // Correct position to avoid sticking
-                        end else if(collisionX2) begin // Right border collision: Reverse to left direction
-                            ball_dirX <= 1'b1;
-                            ballPX <= RIGHT_BORDER - BALL_HALF_WIDTH - BALL_SPEED_X; // Correct position to avoid sticking
-                        end else begin // No horizontal collision: Move ball in current direction
-                            ballPX <= ballPX + (ball_dirX ? -BALL_SPEED_X : BALL_SPEED_X);
+                        // Pre-game start: Paddle movement (user input) with ball locked to paddle
+                        // Ball follows paddle horizontally, vertical position fixed to initial value
+                        if(!game_started_next && !winGame_next && !endGame) begin
+                            // Paddle left movement: Only if left button is pressed and paddle is within left boundary
+                            if(~left && (paddlePX - PADDLE_WIDTH/2 > LEFT_BORDER)) begin
+                                paddlePX <= paddlePX - PADDLE_SPEED; // Move paddle left
+                                ballPX <= paddlePX - PADDLE_SPEED;   // Lock ball to paddle (left movement)
+                            end
+                            // Paddle right movement: Only if right button is pressed and paddle is within right boundary
+                            else if(~right && (paddlePX + PADDLE_WIDTH/2 < RIGHT_BORDER)) begin
+                                paddlePX <= paddlePX + PADDLE_SPEED; // Move paddle right
+                                ballPX <= paddlePX + PADDLE_SPEED;   // Lock ball to paddle (right movement)
+                            end
+                            // Fix ball vertical position to initial value (pre-game start)
+                            ballPY <= BALL_INIT_Y;
                         end
+                    
+                        // Post-game start: Active ball/paddle movement & collision response (non-win/loss)
+                        else if(game_started_next && !winGame_next && !endGame) begin
+                            // Ball horizontal position & direction update (border collision response)
+                            if(collisionX1) begin // Left border collision: Reverse to right direction
+                                ball_dirX <= 1'b0;
+                                ballPX <= LEFT_BORDER + BALL_HALF_WIDTH + BALL_SPEED_X; // Correct position to avoid sticking
+                            end else if(collisionX2) begin // Right border collision: Reverse to left direction
+                                ball_dirX <= 1'b1;
+                                ballPX <= RIGHT_BORDER - BALL_HALF_WIDTH - BALL_SPEED_X; // Correct position to avoid sticking
+                            end else begin // No horizontal collision: Move ball in current direction
+                                ballPX <= ballPX + (ball_dirX_next ? -BALL_SPEED_X : BALL_SPEED_X);
+                            end
                         
-                        // Ball vertical position & direction update (paddle/top/bottom border collision response)
-                        if(collisionPaddle) begin // Paddle collision: Reverse to up direction
-                            ball_dirY <= 1'b1;
-                            ballPY <= paddlePY - PADDLE_HEIGHT/2 - BALL_HALF_HEIGHT - 1; // Correct position to avoid sticking
-                        end 
-                        else if(collisionY1) begin // Top border collision: Reverse to down direction
-                            ball_dirY <= 1'b0;
-                            ballPY <= TOP_BORDER + BALL_HALF_HEIGHT + BALL_SPEED_Y; // Correct position to avoid sticking
-                        end 
-                        else if(collisionBottom) begin // Bottom border collision: Trigger game over
-                            endGame <= 1'b1; // Set endGame flag high (persistent until reset)
-                        end 
-                        else begin // No vertical collision: Move ball in current direction
-                            ballPY <= ballPY + (ball_dirY ? -BALL_SPEED_Y : BALL_SPEED_Y);
-                        end
+                            // Ball vertical position & direction update (paddle/top/bottom border collision response)
+                            if(collisionPaddle) begin // Paddle collision: Reverse to up direction
+                                ball_dirY <= 1'b1;
+                                ballPY <= paddlePY - PADDLE_HEIGHT/2 - BALL_HALF_HEIGHT - 1; // Correct position to avoid sticking
+                            end 
+                            else if(collisionY1) begin // Top border collision: Reverse to down direction
+                                ball_dirY <= 1'b0;
+                                ballPY <= TOP_BORDER + BALL_HALF_HEIGHT + BALL_SPEED_Y; // Correct position to avoid sticking
+                            end 
+                            else if(collisionBottom) begin // Bottom border collision: Trigger game over
+                                endGame <= 1'b1; // Set endGame flag high (persistent until reset)
+                            end 
+                            else begin // No vertical collision: Move ball in current direction
+                                ballPY <= ballPY + (ball_dirY_next ? -BALL_SPEED_Y : BALL_SPEED_Y);
+                            end
                         
-                        // Paddle movement (user input, boundary-constrained) - post game start
-                        // Same logic as pre-game start, but ball is not locked to paddle
-                        if(~left && (paddlePX - PADDLE_WIDTH/2 > LEFT_BORDER)) begin
-                            paddlePX <= paddlePX - PADDLE_SPEED;
-                        end else if(~right && (paddlePX + PADDLE_WIDTH/2 < RIGHT_BORDER)) begin
-                            paddlePX <= paddlePX + PADDLE_SPEED;
+                            // Paddle movement (user input, boundary-constrained) - post game start
+                            // Same logic as pre-game start, but ball is not locked to paddle
+                            if(~left && (paddlePX - PADDLE_WIDTH/2 > LEFT_BORDER)) begin
+                                paddlePX <= paddlePX - PADDLE_SPEED;
+                            end else if(~right && (paddlePX + PADDLE_WIDTH/2 < RIGHT_BORDER)) begin
+                                paddlePX <= paddlePX + PADDLE_SPEED;
+                            end
                         end
                     end
                 end
@@ -649,8 +711,8 @@ module breakout(
     end
     
     // ------------------------------ Graphics Signal Assignments (Combinational Logic) ------------------------------
-    // Ball horizontal pixel flag: 1 when cX is within ball's horizontal range, 0 otherwise (edge-based)
-    assign ballX = (cX == ballPX - BALL_HALF_WIDTH) ? 1'b1 : (cX == ballPX + BALL_HALF_WIDTH) ? 1'b0 : ballX;
+    // Ball horizontal pixel flag: 1 when cX is within ball's horizontal range, 0 otherwise (interval check)
+    assign ballX = (cX >= ballPX - BALL_HALF_WIDTH) & (cX < ballPX + BALL_HALF_WIDTH);
     // Brick collision detection: Active high when any brick is active and ball is present (composite flag)
     assign brickCollision = |bricks & ball;
     // Bounceable object flag: Active high when current pixel is border, paddle, or brick (valid collision targets)
@@ -662,14 +724,14 @@ module breakout(
                     (cY==TOP_BORDER) | (cY==BOTTOM_BORDER);
     // Graphics coordinate aliases: Simplify downstream graphics logic (cX/cY → gX/gY)
     assign gX = cX; assign gY = cY;
-    // Ball vertical pixel flag: 1 when cY is within ball's vertical range, 0 otherwise (edge-based)
-    assign ballY = (cY == ballPY - BALL_HALF_HEIGHT) ? 1'b1 : (cY == ballPY + BALL_HALF_HEIGHT) ? 1'b0 : ballY;
+    // Ball vertical pixel flag: 1 when cY is within ball's vertical range, 0 otherwise (interval check)
+    assign ballY = (cY >= ballPY - BALL_HALF_HEIGHT) & (cY < ballPY + BALL_HALF_HEIGHT);
     // Composite ball flag: Active high when current pixel is part of the ball (ballX & ballY)
     assign ball = ballX & ballY;
-    // Paddle horizontal pixel flag: 1 when cX is within paddle's horizontal range, 0 otherwise (edge-based)
-    assign paddleX = (cX == paddlePX - PADDLE_WIDTH/2) ? 1'b1 : (cX == paddlePX + PADDLE_WIDTH/2 - 1) ? 1'b0 : paddleX;
-    // Paddle vertical pixel flag: 1 when cY is within paddle's vertical range, 0 otherwise (edge-based)
-    assign paddleY = (cY == paddlePY - PADDLE_HEIGHT/2) ? 1'b1 : (cY == paddlePY + PADDLE_HEIGHT/2 - 1) ? 1'b0 : paddleY;
+    // Paddle horizontal pixel flag: 1 when cX is within paddle's horizontal range, 0 otherwise (interval check)
+    assign paddleX = (cX >= paddlePX - PADDLE_WIDTH/2) & (cX < paddlePX + PADDLE_WIDTH/2 - 1);
+    // Paddle vertical pixel flag: 1 when cY is within paddle's vertical range, 0 otherwise (interval check)
+    assign paddleY = (cY >= paddlePY - PADDLE_HEIGHT/2) & (cY < paddlePY + PADDLE_HEIGHT/2 - 1);
     // Composite paddle flag: Active high when current pixel is part of the paddle (paddleX & paddleY)
     assign paddle = paddleX & paddleY;
     
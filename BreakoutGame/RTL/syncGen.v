@@ -7,16 +7,18 @@
  *           vertical sync (vsync), pixel counters (hcount/vcount), and a display area flag (inDispArea).
  *           Implements standard VGA timing parameters to control video output rendering.
  * Port List:
- *   - Input:  clock   - Pixel clock signal for VGA timing synchronization
+ *   - Input:  clock   - System clock signal for VGA timing synchronization
+ *   - Input:  enable  - Pixel clock enable: the timing advances by one pixel on each clock edge
+ *                       where enable is high, so no derived clock is needed for the pixel rate
  *   - Output: hsync   - Horizontal sync signal (low-active for VGA standard timing)
  *   - Output: vsync   - Vertical sync signal (low-active for VGA standard timing)
  *   - Output: inDispArea - High when current pixel is within the visible display area
  *   - Output: hcount  - 10-bit horizontal pixel counter (tracks column position of current pixel)
  *   - Output: vcount  - 10-bit vertical pixel counter (tracks row position of current pixel)
  */
-module syncGen(clock, hsync, vsync, hcount, vcount, inDispArea);
-    // Input port: VGA pixel clock
-    input clock;
+module syncGen(clock, enable, hsync, vsync, hcount, vcount, inDispArea);
+    // Input ports: system clock and VGA pixel clock enable
+    input clock, enable;
     
     // Output ports: VGA control signals and pixel counters
     output hsync, vsync, inDispArea;
@@ -60,10 +62,10 @@ module syncGen(clock, hsync, vsync, hcount, vcount, inDispArea);
 
     /**
      * Sequential Logic Block: VGA Timing State Machine
-     * Triggered on the positive edge of the pixel clock.
+     * Triggered on the positive edge of the system clock, advances only when the pixel clock enable is high.
      * Updates pixel counters, sync signals, blanking signals, and display area flags per VGA timing standards.
      */
-    always @(posedge clock) begin
+    always @(posedge clock) if(enable) begin
         // Update horizontal/vertical display area flags and composite display area flag
         inDispAreaX <= hreset ? 1 : hblankon ? 0 : inDispAreaX;
         inDispAreaY <= vreset ? 1 : vblankon ? 0 : inDispAreaY;
@@ -80,4 +82,32 @@ module syncGen(clock, hsync, vsync, hcount, vcount, inDispArea);
         vblank <= vreset ? 0 : vblankon ? 1 : vblank;
         vsync <= vson ? 0 : vsoff ? 1 : vsync;
     end
+
+`ifdef VGA_PIXEL_SINK
+    /**
+     * Simulation-only Pixel Sink (Verilator, +define+VGA_PIXEL_SINK, see harness/vga_board.h):
+     * Reports every active pixel and the end of each frame to the simulator through DPI-C, so it
+     * places pixels exactly and skips all sync tracking on blanking cycles.
+     * - vga_sink_pixel: the counters move to active pixel (x, y) on this edge; the simulator reads
+     *                   its colour from the rgb port once the edge has settled
+     * - vga_sink_frame: the last active line of the 640x480 frame is done (same edge as vblankon)
+     */
+    import "DPI-C" function void vga_sink_attach();
+    import "DPI-C" function void vga_sink_pixel(input int x, input int y);
+    import "DPI-C" function void vga_sink_frame(input int width, input int height);
+
+    // Counter values after this edge (same expressions as the timing block)
+    wire [9:0] hcount_next, vcount_next;
+    assign hcount_next = hreset ? 0 : hcount + 1;
+    assign vcount_next = hreset ? (vreset ? 0 : vcount + 1) : vcount;
+
+    initial vga_sink_attach();
+
+    always @(posedge clock) if(enable) begin
+        if((hcount_next < 640) & (vcount_next < 480))
+            vga_sink_pixel({22'd0, hcount_next}, {22'd0, vcount_next});
+        else if(vblankon)
+            vga_sink_frame(640, 480);
+    end
+`endif
 endmodule
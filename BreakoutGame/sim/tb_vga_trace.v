@@ -0,0 +1,116 @@
+`timescale 1ns/1ps
+
+/**
+ * Module: tb_vga_trace
+ * Function: Drives DevelopmentBoard from a scripted input file and writes its VGA output as a trace,
+ *           so that two revisions of the RTL can be compared cycle by cycle (see compare_vga_traces.sh).
+ * Plusargs:
+ *   - +input=<file>  - Input script, one line per change: "<cycle> <reset> <B2> <B3> <B4> <B5>".
+ *                      The levels apply from that board clock cycle on (buttons are active low).
+ *   - +trace=<file>  - Output trace, one line whenever h_sync, v_sync or rgb changes:
+ *                      "<cycle> <h_sync> <v_sync> <rgb in hex>", sampled after each rising clock edge.
+ *   - +frames=<n>    - Number of frames (falling edges of v_sync) to trace before finishing.
+ */
+module tb_vga_trace();
+
+// Declare artificial input signal
+ reg clk = 1'b0;
+ reg reset = 1'b1;
+ reg B2 = 1'b1, B3 = 1'b1, B4 = 1'b1, B5 = 1'b1;
+// Declare output record signal
+ wire h_sync, v_sync;
+ wire [15:0] rgb;
+ wire led1, led2, led3, led4, led5;
+
+// Trace state
+ integer in_fd, trace_fd, frames, frame_count, status;
+ integer next_cycle, next_reset, next_b2, next_b3, next_b4, next_b5;
+ reg [63:0] cycle = 0;
+ reg last_h = 1'b0, last_v = 1'b0;
+ reg [15:0] last_rgb = 16'h0;
+ reg have_next = 1'b0;
+ reg started = 1'b0;
+ reg [8*256-1:0] input_file, trace_file;
+
+// Open the input script and the trace
+ initial begin
+	 if(!$value$plusargs("input=%s", input_file) || !$value$plusargs("trace=%s", trace_file)) begin
+		 $display("Usage: +input=<file> +trace=<file> [+frames=<n>]");
+		 $finish;
+	 end
+	 if(!$value$plusargs("frames=%d", frames))
+		 frames = 60;
+	 frame_count = 0;
+	 in_fd = $fopen(input_file, "r");
+	 trace_fd = $fopen(trace_file, "w");
+	 if(in_fd == 0 || trace_fd == 0) begin
+		 $display("Error: cannot open %0s or %0s", input_file, trace_file);
+		 $finish;
+	 end
+	 read_next();
+ end
+
+// Read the next line of the input script
+ task read_next;
+	 begin
+		 status = $fscanf(in_fd, "%d %d %d %d %d %d\n", next_cycle, next_reset, next_b2, next_b3, next_b4, next_b5);
+		 have_next = (status == 6);
+	 end
+ endtask
+
+ //Generate board clock
+ always #10 clk = ~clk;
+
+// Apply the input changes that are due, before the rising edge of their cycle
+ always @(negedge clk) begin
+	 while(have_next && next_cycle <= cycle) begin
+		 reset = next_reset[0];
+		 B2 = next_b2[0];
+		 B3 = next_b3[0];
+		 B4 = next_b4[0];
+		 B5 = next_b5[0];
+		 read_next();
+	 end
+ end
+
+// Write the VGA outputs whenever they change, count frames on falling edges of v_sync
+ always @(posedge clk) begin
+	 #1;
+	 if(!started || h_sync != last_h || v_sync != last_v || rgb != last_rgb)
+		 $fwrite(trace_fd, "%0d %0d %0d %04h\n", cycle, h_sync, v_sync, rgb);
+	 if(started && last_v && !v_sync) begin
+		 frame_count = frame_count + 1;
+		 if(frame_count >= frames) begin
+			 $fclose(trace_fd);
+			 $finish;
+		 end
+	 end
+	 started = 1'b1;
+	 last_h = h_sync;
+	 last_v = v_sync;
+	 last_rgb = rgb;
+	 cycle = cycle + 1;
+ end
+
+
+ //------------- DevelopmentBoard_inst -------------
+ DevelopmentBoard DevelopmentBoard_inst
+ (
+ .clk (clk ),
+ .reset (reset ),
+ .B2 (B2 ),
+ .B3 (B3 ),
+ .B4 (B4 ),
+ .B5 (B5 ),
+
+ .h_sync (h_sync ),
+ .v_sync (v_sync ),
+ .rgb (rgb ),
+ .led1 (led1 ),
+ .led2 (led2 ),
+ .led3 (led3 ),
+ .led4 (led4 ),
+ .led5 (led5 )
+ );
+
+endmodule
@@ -62,5 +62,31 @@ assign pix_y = pix_pre_req ? (cnt_v - (V_SYNC + V_BACK)) : 10'd0;
 
 assign rgb = pixel_valid ? pix_data : 16'h0000;
 
+`ifdef VGA_PIXEL_SINK
+// 仅用于仿真 (Verilator +define+VGA_PIXEL_SINK，见 harness/vga_board.h):
+// 通过 DPI-C 报告这个时钟沿后计数器所在的有效像素，以及最后一个有效行结束 (连同有效区大小)
+import "DPI-C" function void vga_sink_attach();
+import "DPI-C" function void vga_sink_pixel(input int x, input int y);
+import "DPI-C" function void vga_sink_frame(input int width, input int height);
+
+wire [9:0] cnt_h_next;
+wire [9:0] cnt_v_next;
+
+assign cnt_h_next = (cnt_h == H_TOTAL - 1'd1) ? 10'd0 : cnt_h + 1'd1;
+assign cnt_v_next = (cnt_h != H_TOTAL - 1'd1) ? cnt_v : (cnt_v == V_TOTAL - 1'd1) ? 10'd0 : cnt_v + 1'd1;
+
+initial vga_sink_attach();
+
+always @(posedge vga_clk) begin
+    if (sys_rst_n) begin
+        if ((cnt_h_next >= H_SYNC + H_BACK) && (cnt_h_next < H_SYNC + H_BACK + H_VALID)
+         && (cnt_v_next >= V_SYNC + V_BACK) && (cnt_v_next < V_SYNC + V_BACK + V_VALID))
+            vga_sink_pixel({22'd0, cnt_h_next - (H_SYNC + H_BACK)}, {22'd0, cnt_v_next - (V_SYNC + V_BACK)});
+        else if ((cnt_h == H_TOTAL - 1'd1) && (cnt_v == V_SYNC + V_BACK + V_VALID - 1'd1))
+            vga_sink_frame({22'd0, H_VALID}, {22'd0, V_VALID});
+    end
+end
+`endif
+
 endmodule
 
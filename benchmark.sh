@@ -0,0 +1,62 @@
+#!/bin/bash
+
+# 仿真性能测试: 对 BreakoutGame 和 Lab4 (ColorBar) 分别按每种构建配置 (debug/release/pgo)
+# 和 1/2/4/8 线程构建模型，无界面运行固定的周期数并比较 cycles/s，
+# 用来为每个设计选择构建配置和线程数。speedup 相对于同样线程数的 release 配置，
+# scaling 相对于同一构建配置的第一个线程数。
+# 用法: ./benchmark.sh [周期数] [线程数列表] [构建配置列表]
+#   e.g. ./benchmark.sh
+#        ./benchmark.sh 200000000 "1 2 4 8 16" "release pgo"
+# pgo 配置的训练负载由 PGO_WORKLOAD 指定 (见 run_simulation.sh)
+
+CYCLES=${1:-100000000}
+THREAD_COUNTS=${2:-"1 2 4 8"}
+PROFILES=${3:-"debug release pgo"}
+DESIGNS="BreakoutGame Lab4"
+
+# 获取脚本所在的绝对路径
+ROOT_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+CPUS=$(nproc)
+
+# 构建并运行一个配置，cycles/s 存入 RATE: rate <设计> <构建配置> <线程数>
+rate() {
+    # 每个配置重新构建模型 (无 GL)，无界面运行 (仿真器把模型线程各自固定在一个核上)
+    OUTPUT=$(cd "$ROOT_DIR/$1/sim" && NO_GL=1 THREADS=$3 PROFILE=$2 bash run_simulation.sh ../RTL --headless --cycles=$CYCLES 2>&1)
+    # pgo 的训练运行也会输出一次，取最后一次 (正式运行) 的结果
+    RATE=$(echo "$OUTPUT" | awk -F': ' '/^cycles\/s/ {rate = $2} END {print rate}')
+    if [ -z "$RATE" ]; then
+        echo "Error: $1 ($2, $3 threads) failed to build or run:"
+        echo "$OUTPUT" | tail -20
+        exit 1
+    fi
+}
+
+# 加速比相对于同一设计、同样线程数的 release 配置，release 总是先测
+PROFILES="release $(echo $PROFILES | tr ' ' '\n' | grep -v -x release | tr '\n' ' ')"
+
+echo "Cycles per run: $CYCLES, CPUs: $CPUS"
+echo "speedup: vs release with the same thread count, scaling: vs the same profile with the first thread count"
+printf "%-14s %-8s %8s %16s %10s %10s\n" "design" "profile" "threads" "cycles/s" "speedup" "scaling"
+for DESIGN in $DESIGNS; do
+    declare -A FIRST=()
+    for T in $THREAD_COUNTS; do
+        # 线程数超过 CPU 数时结果没有意义
+        if [ "$T" -gt "$CPUS" ]; then
+            printf "%-14s %-8s %8s %16s\n" "$DESIGN" "-" "$T" "skipped"
+            continue
+        fi
+        BASE=""
+        for PROFILE in $PROFILES; do
+            rate "$DESIGN" "$PROFILE" "$T"
+            if [ -z "$BASE" ]; then
+                BASE=$RATE
+            fi
+            if [ -z "${FIRST[$PROFILE]}" ]; then
+                FIRST[$PROFILE]=$RATE
+            fi
+            SPEEDUP=$(awk -v r="$RATE" -v b="$BASE" 'BEGIN { printf "%.2fx", r / b }')
+            SCALING=$(awk -v r="$RATE" -v b="${FIRST[$PROFILE]}" 'BEGIN { printf "%.2fx", r / b }')
+            printf "%-14s %-8s %8s %16.0f %10s %10s\n" "$DESIGN" "$PROFILE" "$T" "$RATE" "$SPEEDUP" "$SCALING"
+        done
+    done
+done
@@ -0,0 +1,76 @@
+#!/bin/bash
+
+# 比较两个 git 版本的 VGA 输出: 对每个版本取出 BreakoutGame 的 RTL，和当前的
+# sim/DevelopmentBoard.v、sim/tb_vga_trace.v 一起用 verilator --binary 构建，按脚本化的输入
+# (sim/trace_input.txt) 运行 N 帧，记录每个时钟周期 h_sync/v_sync/rgb 的变化，再逐行比较
+# 两份记录。用来确认 RTL 的重构 (例如把派生时钟换成时钟使能) 不改变输出。
+# 用法: ./compare_vga_traces.sh <旧版本> <新版本> [帧数] [输入脚本]
+#   e.g. ./compare_vga_traces.sh df555a3~1 df555a3 120
+# 版本必须明确给出 (提交哈希或标签)，输入脚本的格式见 tb_vga_trace.v。
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 <old revision> <new revision> [frames] [input script]"
+    echo "  e.g. $0 df555a3~1 df555a3 120"
+    exit 1
+fi
+OLD_REV=$1
+NEW_REV=$2
+FRAMES=${3:-120}
+
+# 获取脚本所在的绝对路径
+ROOT_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+SIM_DIR="$ROOT_DIR/BreakoutGame/sim"
+INPUT=$(realpath "${4:-$SIM_DIR/trace_input.txt}")
+
+if ! command -v verilator > /dev/null; then
+    echo "Error: Verilator is not installed (install command: sudo apt install build-essential verilator)"
+    exit 1
+fi
+
+TMP_DIR=$(mktemp -d)
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+# 构建并运行一个版本，记录写到 $TMP_DIR/<名字>.trace: trace <名字> <版本>
+trace() {
+    local REV_DIR="$TMP_DIR/$1"
+    mkdir -p "$REV_DIR"
+    if ! git -C "$ROOT_DIR" archive "$2" BreakoutGame/RTL | tar -x -C "$REV_DIR"; then
+        echo "Error: cannot read BreakoutGame/RTL at revision $2"
+        exit 1
+    fi
+
+    # X 初值和 X 赋值都取 0，两个版本从同样的状态开始
+    echo "Build $2..."
+    if ! verilator --binary -Wno-fatal --x-assign 0 --x-initial 0 --top-module tb_vga_trace --Mdir "$REV_DIR/obj_dir" \
+        -I"$REV_DIR/BreakoutGame/RTL" "$SIM_DIR/tb_vga_trace.v" "$SIM_DIR/DevelopmentBoard.v" > "$REV_DIR/build.log" 2>&1; then
+        echo "Error: Verilator build of $2 failed:"
+        tail -20 "$REV_DIR/build.log"
+        exit 1
+    fi
+
+    echo "Run $2 for $FRAMES frames..."
+    "$REV_DIR/obj_dir/Vtb_vga_trace" +input="$INPUT" +trace="$TMP_DIR/$1.trace" +frames="$FRAMES" > /dev/null
+    if [ ! -s "$TMP_DIR/$1.trace" ]; then
+        echo "Error: $2 did not write a trace"
+        exit 1
+    fi
+}
+
+trace old "$OLD_REV"
+trace new "$NEW_REV"
+
+# 逐行比较: 每行是一次输出变化 "<周期> <h_sync> <v_sync> <rgb>"
+echo "Input script: $INPUT, frames: $FRAMES"
+printf "%-14s %12s %12s %s\n" "revision" "cycles" "changes" "sha256"
+for NAME in old new; do
+    if [ "$NAME" = "old" ]; then REV=$OLD_REV; else REV=$NEW_REV; fi
+    printf "%-14s %12s %12s %s\n" "$REV" "$(tail -1 "$TMP_DIR/$NAME.trace" | cut -d " " -f 1)" \
+        "$(wc -l < "$TMP_DIR/$NAME.trace")" "$(sha256sum "$TMP_DIR/$NAME.trace" | cut -d " " -f 1)"
+done
+if cmp -s "$TMP_DIR/old.trace" "$TMP_DIR/new.trace"; then
+    echo "✓ VGA output traces are identical"
+    exit 0
+fi
+echo "VGA output traces differ, first differences (cycle h_sync v_sync rgb):"
+diff "$TMP_DIR/old.trace" "$TMP_DIR/new.trace" | head -20
+exit 1
@@ -0,0 +1,95 @@
+#!/bin/bash
+
+# 统计模型每次 eval() 的调度循环次数: 对每个 git 版本取出设计的 RTL，构建一个 gprof
+# 插桩的仿真器 (Verilator 选项同 release，C++ 用 -O0 -pg 编译，不内联，gprof 才能数到每个
+# 函数的调用)，无界面运行固定的周期数，再从 gprof 的调用次数算出平均
+# 每次 eval() 执行了几次 act 阶段 (eval_phase__act) 和 nba 阶段 (eval_phase__nba)。
+# 组合逻辑的反馈会被 Verilator 当作触发条件，每次变化都多跑一轮 act 循环；比较改动
+# 前后的版本，确认模型一轮就能稳定下来。
+# 用法: ./eval_loop_stats.sh <设计> <周期数> <git 版本列表>
+#   e.g. ./eval_loop_stats.sh BreakoutGame 1000000 "4f85e9b 6d22558"
+# 版本必须明确给出 (提交哈希或标签): 像 HEAD~1 这样的相对版本在后续提交后就不再指向
+# 改动前的版本。
+# 只取各版本的 <设计>/RTL，sim 目录 (DevelopmentBoard.v、simulator.cpp) 用当前的。
+# 需要 gprof (binutils)。
+
+if [ $# -lt 3 ]; then
+    echo "Usage: $0 <design> <cycles> <revisions>"
+    echo "  e.g. $0 BreakoutGame 1000000 \"4f85e9b 6d22558\""
+    exit 1
+fi
+DESIGN=$1
+CYCLES=$2
+REVISIONS=$3
+
+# 获取脚本所在的绝对路径
+ROOT_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+SIM_DIR="$ROOT_DIR/$DESIGN/sim"
+
+if ! command -v gprof > /dev/null; then
+    echo "Error: gprof is not installed (install command: sudo apt install binutils)"
+    exit 1
+fi
+
+if ! command -v verilator > /dev/null; then
+    echo "Error: Verilator is not installed (install command: sudo apt install build-essential verilator)"
+    exit 1
+fi
+
+# 不依赖 GLUT 的 debug 版仿真器库 (见 harness/build_harness.sh)
+HARNESS_DIR="$ROOT_DIR/harness"
+NO_GL=1 bash "$HARNESS_DIR/build_harness.sh" debug > /dev/null || exit 1
+HARNESS_LIB="$HARNESS_DIR/obj_debug_nogl/libvgaharness.a"
+
+TMP_DIR=$(mktemp -d)
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+# 构建一个版本的插桩仿真器: build_gprof <版本目录>
+build_gprof() {
+    verilator -Wall --cc --exe -O3 --x-assign fast --x-initial fast --Mdir "$1/obj_dir" -I"$1/$DESIGN/RTL" \
+        "$SIM_DIR/simulator.cpp" "$SIM_DIR/DevelopmentBoard.v" -CFLAGS -I"$HARNESS_DIR" \
+        -LDFLAGS "$HARNESS_LIB" -LDFLAGS -pg > "$1/build.log" 2>&1 &&
+    make -j -C "$1/obj_dir" -f VDevelopmentBoard.mk VDevelopmentBoard \
+        OPT_FAST="-O0 -pg" OPT_SLOW="-O0 -pg" OPT_GLOBAL="-O0 -pg" VK_GLOBAL_OBJS= >> "$1/build.log" 2>&1
+}
+
+# gprof 平面 profile 中某个模型函数的调用次数: calls <函数名后缀>
+calls() {
+    echo "$PROFILE_OUTPUT" | awk -v name="$1" '$NF ~ ("___" name "\\(") && NF >= 7 { n += $4 } END { print n + 0 }'
+}
+
+echo "Design: $DESIGN, cycles per run: $CYCLES (2 evals per cycle)"
+printf "%-12s %12s %12s %10s %10s\n" "revision" "evals" "act phases" "act/eval" "nba/eval"
+for REV in $REVISIONS; do
+    # 取出该版本的 RTL
+    REV_DIR="$TMP_DIR/$(echo "$REV" | tr -c 'A-Za-z0-9_.\n' '_')"
+    mkdir -p "$REV_DIR"
+    if ! git -C "$ROOT_DIR" archive "$REV" "$DESIGN/RTL" | tar -x -C "$REV_DIR"; then
+        echo "Error: cannot read $DESIGN/RTL at revision $REV"
+        exit 1
+    fi
+
+    # 插桩构建并无界面运行，退出时在当前目录写出 gmon.out
+    if ! build_gprof "$REV_DIR"; then
+        echo "Error: $DESIGN at $REV failed to build:"
+        tail -20 "$REV_DIR/build.log"
+        exit 1
+    fi
+    OUTPUT=$(cd "$REV_DIR" && "$REV_DIR/obj_dir/VDevelopmentBoard" --headless --cycles=$CYCLES 2>&1)
+    if [ ! -f "$REV_DIR/gmon.out" ]; then
+        echo "Error: $DESIGN at $REV failed to run:"
+        echo "$OUTPUT" | tail -20
+        exit 1
+    fi
+    PROFILE_OUTPUT=$(gprof -b -p "$REV_DIR/obj_dir/VDevelopmentBoard" "$REV_DIR/gmon.out")
+
+    EVALS=$(calls eval)
+    ACT=$(calls eval_phase__act)
+    NBA=$(calls eval_phase__nba)
+    if [ "$EVALS" -eq 0 ]; then
+        echo "Error: no eval() calls in the profile of $DESIGN at $REV"
+        exit 1
+    fi
+    awk -v rev="$REV" -v e="$EVALS" -v a="$ACT" -v n="$NBA" \
+        'BEGIN { printf "%-12s %12d %12d %10.3f %10.3f\n", rev, e, a, a / e, n / e }'
+done
@@ -0,0 +1,96 @@
+#!/bin/bash
+
+# 构建各工程共用的仿真器库: vga_harness.cpp 和 Verilator 运行时 (verilated.cpp、
+# verilated_threads.cpp、verilated_save.cpp) 每种构建配置只编译一次，打包成
+# obj_<profile>[_nogl]/libvgaharness.a，由 run_simulation.sh 链接。
+# 同时构建通用的查看器 obj_<profile>[_nogl]/vga_sim，它在运行时加载以插件形式
+# 构建的模型 (PLUGIN=1 run_simulation.sh，见 vga_plugin.h)。
+# 用法: ./build_harness.sh [debug|release]
+#        NO_GL=1 ./build_harness.sh release     # 不依赖 GLUT 的无界面版本
+# 源文件、Verilator 版本和编译选项都没变时沿用已有的库。
+
+PROFILE=${1:-release}
+case "$PROFILE" in
+    debug)
+        CXX_OPT="-O0 -g"
+        ;;
+    release)
+        CXX_OPT="-O3 -march=native -flto"
+        ;;
+    *)
+        echo "Error: unknown harness profile '$PROFILE' (debug or release)"
+        exit 1
+        ;;
+esac
+
+# 获取脚本所在的绝对路径
+HARNESS_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+
+if [ "$NO_GL" = "1" ]; then
+    GL_DEFINE="-DSIM_NO_GL"
+    GL_LIBS=""
+    OUT_DIR="$HARNESS_DIR/obj_${PROFILE}_nogl"
+else
+    GL_DEFINE=""
+    GL_LIBS="-lglut -lGLU -lGL"
+    OUT_DIR="$HARNESS_DIR/obj_$PROFILE"
+fi
+LIB="$OUT_DIR/libvgaharness.a"
+
+VERILATOR_ROOT=$(verilator --getenv VERILATOR_ROOT 2> /dev/null)
+if [ -z "$VERILATOR_ROOT" ] || [ ! -f "$VERILATOR_ROOT/include/verilated.cpp" ]; then
+    echo "Error: Verilator runtime sources not found"
+    echo "Verilator is not installed (install command: sudo apt install build-essential verilator)"
+    exit 1
+fi
+RUNTIME="$VERILATOR_ROOT/include/verilated.cpp $VERILATOR_ROOT/include/verilated_threads.cpp $VERILATOR_ROOT/include/verilated_save.cpp"
+SOURCES="$HARNESS_DIR/vga_harness.cpp $RUNTIME"
+
+CXXFLAGS="-std=gnu++17 -pthread $CXX_OPT $GL_DEFINE -I$HARNESS_DIR -I$VERILATOR_ROOT/include -I$VERILATOR_ROOT/include/vltstd \
+-DVM_COVERAGE=0 -DVM_SC=0 -DVM_TRACE=0 -DVM_TRACE_FST=0 -DVM_TRACE_VCD=0 -faligned-new"
+
+# 有 ccache 时用它缓存编译结果; LTO 目标文件要用 gcc-ar 打包
+CCACHE=""
+if command -v ccache > /dev/null; then
+    CCACHE="ccache"
+fi
+AR="ar"
+if command -v gcc-ar > /dev/null; then
+    AR="gcc-ar"
+fi
+
+# 缓存的键: Verilator 版本、编译选项和所有源文件的内容
+KEY=$({
+    verilator --version
+    echo "$CXXFLAGS"
+    cat $SOURCES "$HARNESS_DIR/vga_harness.h" "$HARNESS_DIR/vga_sim.cpp" "$HARNESS_DIR/vga_plugin.h"
+} | sha256sum | cut -d " " -f 1)
+if [ -f "$LIB" ] && [ -f "$OUT_DIR/vga_sim" ] && [ "$(cat "$OUT_DIR/build.key" 2> /dev/null)" = "$KEY" ]; then
+    echo "✓ Harness library is up to date: $LIB"
+    exit 0
+fi
+
+echo "Build the harness library ($PROFILE)..."
+rm -rf "$OUT_DIR"
+mkdir -p "$OUT_DIR"
+PIDS=""
+LIB_OBJS=""
+for SRC in $SOURCES "$HARNESS_DIR/vga_sim.cpp"; do
+    OBJ="$OUT_DIR/$(basename "${SRC%.cpp}").o"
+    $CCACHE ${CXX:-g++} $CXXFLAGS -c "$SRC" -o "$OBJ" &
+    PIDS="$PIDS $!"
+    # vga_sim.o 有 main()，不放进库
+    if [ "$SRC" != "$HARNESS_DIR/vga_sim.cpp" ]; then
+        LIB_OBJS="$LIB_OBJS $OBJ"
+    fi
+done
+for PID in $PIDS; do
+    if ! wait $PID; then
+        echo "Error: Harness library build failed!"
+        exit 1
+    fi
+done
+$AR rcs "$LIB" $LIB_OBJS || exit 1
+${CXX:-g++} $CXXFLAGS "$OUT_DIR/vga_sim.o" "$LIB" -o "$OUT_DIR/vga_sim" $GL_LIBS -ldl || exit 1
+echo "$KEY" > "$OUT_DIR/build.key"
+echo "✓ Harness library built successfully: $LIB"
@@ -0,0 +1,310 @@
+#!/bin/bash
+
+# 各工程共用的仿真构建脚本: 用 Verilator 生成设计的模型，链接共用的仿真器库
+# (build_harness.sh) 并运行。各工程的 sim/run_simulation.sh 只是传入自己的设计目录
+# (含 simulator.cpp 和 DevelopmentBoard.v) 和 RTL 目录的包装。
+# 用法: harness/run_simulation.sh <design_directory> <include_directory> [simulator options...]
+#   e.g. 在工程的 sim 目录中:
+#        ./run_simulation.sh ../RTL --present=rects
+#        ./run_simulation.sh ../RTL --headless --frames=600
+# 在没有显示器/OpenGL 的机器上，用 NO_GL=1 构建不依赖 GLUT 的无界面仿真器:
+#        NO_GL=1 ./run_simulation.sh ../RTL --cycles=100000000
+# 用 THREADS=N 构建 N 线程的模型 (verilator --threads N)。仿真器把每个模型线程固定在
+# 一个独立的物理核上，GUI 和录制线程用其余的 CPU (仿真器选项 --no-pin 关闭):
+#        THREADS=4 ./run_simulation.sh ../RTL --headless --cycles=100000000
+# 用 PROFILE 选择构建配置，每种配置在设计目录中有自己的目录 obj_dir_<profile>:
+#   release  默认，-O3 -march=native、LTO、--x-assign/--x-initial fast
+#   debug    不优化，带调试信息
+#   pgo      release + 按实际负载做 profile-guided 优化: 先构建插桩版本并运行
+#            PGO_WORKLOAD (一个 --record-input 录制的输入日志，默认无界面跑
+#            600 帧)，再用采集到的数据重新构建
+#        PROFILE=pgo PGO_WORKLOAD=game.log ./run_simulation.sh ../RTL
+# 用 PLUGIN=1 把模型构建成共享库 obj_dir_<profile>_plugin/VDevelopmentBoard.so，由
+# 通用的查看器 harness/obj_<profile>/vga_sim 加载运行 (debug、release 配置)。在窗口中
+# 按 'm' 重新构建并换上新的模型，窗口和设置保持不变:
+#        PLUGIN=1 ./run_simulation.sh ../RTL
+# VGA 时序模块 (syncGen、vga_ctrl) 默认带 +define+VGA_PIXEL_SINK 编译，通过 DPI-C 把每个
+# 有效像素的坐标和帧结束直接报给仿真器，不再从 h_sync/v_sync 推算扫描位置。用 PIXEL_SINK=0
+# 关闭，改回跟踪同步信号采样 (不报告像素的设计也自动用这种方式):
+#        PIXEL_SINK=0 ./run_simulation.sh ../RTL
+# 用 CXX 选择模型和仿真器库的 C++ 编译器 (默认 g++)，例如 CXX=clang++
+# 用 BUILD_ONLY=1 只构建，不运行仿真
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 <design_directory> <include_directory> [simulator options...]"
+    exit 1
+fi
+
+# OpenGL/GLUT 相关的编译与链接选项
+if [ "$NO_GL" = "1" ]; then
+    GL_FLAGS="-CFLAGS -DSIM_NO_GL"
+    HARNESS_VARIANT="_nogl"
+else
+    GL_FLAGS="-LDFLAGS -lglut -LDFLAGS -lGLU -LDFLAGS -lGL"
+    HARNESS_VARIANT=""
+fi
+
+# 模型线程数，默认单线程
+THREADS=${THREADS:-1}
+if [ "$THREADS" -gt 1 ]; then
+    THREAD_FLAGS="--threads $THREADS"
+else
+    THREAD_FLAGS=""
+fi
+
+# 由模型报告像素 (见 harness/vga_board.h)
+if [ "${PIXEL_SINK:-1}" = "1" ]; then
+    SINK_FLAGS="+define+VGA_PIXEL_SINK"
+else
+    SINK_FLAGS=""
+fi
+
+# 构建配置: Verilator 选项、C++ 编译选项 (OPT_FAST/OPT_SLOW/OPT_GLOBAL) 与链接选项
+PROFILE=${PROFILE:-release}
+case "$PROFILE" in
+    debug)
+        OPT_FLAGS="-O0"
+        CXX_OPT="-O0 -g"
+        LINK_FLAGS=""
+        ;;
+    release|pgo)
+        OPT_FLAGS="-O3 --x-assign fast --x-initial fast"
+        CXX_OPT="-O3 -march=native -flto"
+        LINK_FLAGS="-LDFLAGS -O3 -LDFLAGS -march=native -LDFLAGS -flto=auto"
+        ;;
+    *)
+        echo "Error: unknown PROFILE '$PROFILE' (debug, release or pgo)"
+        exit 1
+        ;;
+esac
+
+# 各工程共用的仿真器库 (build_harness.sh 构建)，pgo 配置链接 release 版本的库
+HARNESS_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+if [ "$PROFILE" = "pgo" ]; then
+    HARNESS_PROFILE=release
+else
+    HARNESS_PROFILE=$PROFILE
+fi
+HARNESS_LIB="$HARNESS_DIR/obj_$HARNESS_PROFILE$HARNESS_VARIANT/libvgaharness.a"
+
+# 检查设计目录和 RTL 目录是否存在 (相对路径按调用者的当前目录解析)
+if [ ! -d "$1" ]; then
+    echo "Error: design directory '$1' does not exist"
+    exit 1
+fi
+DESIGN_DIR=$(cd "$1" && pwd)
+if [ ! -d "$2" ]; then
+    echo "Error: '$2' does not exist"
+    echo "Tip: You can use the project's RTL directory without providing any parameters, or provide a valid directory path"
+    exit 1
+fi
+INCLUDE_DIR=$(cd "$2" && pwd)
+
+echo "Start simulation..."
+echo "Design directory: $DESIGN_DIR"
+echo "Include directories used: $INCLUDE_DIR"
+echo "Build profile: $PROFILE"
+
+# 模型在设计目录中构建
+cd "$DESIGN_DIR" || exit 1
+
+# 检查必要的文件是否存在
+if [ ! -f "simulator.cpp" ]; then
+    echo "Error: simulator.cpp does not exist in $DESIGN_DIR"
+    exit 1
+fi
+
+if [ ! -f "DevelopmentBoard.v" ]; then
+    echo "Error: DevelopmentBoard.v does not exist in $DESIGN_DIR"
+    exit 1
+fi
+
+OBJ_DIR="obj_dir_$PROFILE"
+
+# 模型链接成独立的仿真器，或者 (PLUGIN=1) 链接成 vga_sim 加载的共享库。插件自带
+# Verilator 运行时，和模型一起编译成位置无关代码
+if [ "$PLUGIN" = "1" ]; then
+    if [ "$PROFILE" = "pgo" ]; then
+        echo "Error: PLUGIN=1 supports the debug and release profiles"
+        exit 1
+    fi
+    OBJ_DIR="${OBJ_DIR}_plugin"
+    MODEL_TARGET="VDevelopmentBoard.so"
+    MODEL_ARGS=(-o "$MODEL_TARGET" -CFLAGS -DSIM_PLUGIN -CFLAGS -fPIC -LDFLAGS -shared)
+    MAKE_ARGS=()
+else
+    MODEL_TARGET="VDevelopmentBoard"
+    MODEL_ARGS=(-LDFLAGS "$HARNESS_LIB" $GL_FLAGS)
+    # Verilator 运行时已在仿真器库中，不再编译
+    MAKE_ARGS=(VK_GLOBAL_OBJS=)
+fi
+PGO_DIR="$(pwd)/$OBJ_DIR.profile"
+
+# 有 ccache 时用它缓存编译结果，重新生成模型后没有变化的文件不必再编译
+if command -v ccache > /dev/null; then
+    OBJCACHE_FLAG="OBJCACHE=ccache"
+else
+    OBJCACHE_FLAG=""
+fi
+
+# 构建缓存的键: Verilator 版本、Verilator 参数及其引用的文件 (DevelopmentBoard.v、
+# profile.vlt 等，simulator.cpp 和仿真器库除外，它们由 make 增量编译/重新链接)、
+# C++ 编译选项，以及 RTL 目录下所有源文件的内容
+build_key() {
+    {
+        verilator --version
+        echo "$CXX_FLAGS"
+        for ARG in "$@"; do
+            echo "$ARG"
+            if [ -f "$ARG" ] && [ "$ARG" != "simulator.cpp" ] && [ "$ARG" != "$HARNESS_LIB" ]; then
+                cat "$ARG"
+            fi
+        done
+        find "$INCLUDE_DIR" -maxdepth 1 -type f \( -name "*.v" -o -name "*.sv" -o -name "*.vh" -o -name "*.svh" \) -print0 \
+            | sort -z | xargs -0 -r cat
+    } | sha256sum | cut -d " " -f 1
+}
+
+# 生成模型并构建: build_model <额外的 Verilator 参数...>
+# 额外的 C++ 编译/链接选项放在 EXTRA_CXX 中。RTL 和构建选项都没变时沿用
+# $OBJ_DIR 中已生成的文件，只有 simulator.cpp 改动时只重新编译它并链接
+build_model() {
+    # --savable 让仿真器可以保存/恢复模型状态（快照、'a' 键瞬间重启）
+    VERILATOR_ARGS=(-Wall --cc --exe --savable --Mdir "$OBJ_DIR" $OPT_FLAGS $THREAD_FLAGS $SINK_FLAGS "$@" -I"$INCLUDE_DIR" simulator.cpp DevelopmentBoard.v -CFLAGS -DSIM_SAVABLE -CFLAGS -I"$HARNESS_DIR" "${MODEL_ARGS[@]}" $LINK_FLAGS ${EXTRA_CXX:+-LDFLAGS "$EXTRA_CXX"})
+    CXX_FLAGS="$CXX_OPT $EXTRA_CXX"
+
+    echo "---------------------------------"
+    echo "Step 0: Build the shared harness library and check previously generated files..."
+    NO_GL="$NO_GL" bash "$HARNESS_DIR/build_harness.sh" "$HARNESS_PROFILE" || exit 1
+    KEY=$(build_key "${VERILATOR_ARGS[@]}")
+    if [ -f "$OBJ_DIR/VDevelopmentBoard.mk" ] && [ "$(cat "$OBJ_DIR/build.key" 2> /dev/null)" = "$KEY" ]; then
+        echo "✓ RTL and build options unchanged, reuse $OBJ_DIR"
+    else
+        if [ -d "$OBJ_DIR" ]; then
+            echo "RTL or build options changed, remove $OBJ_DIR ..."
+            if rm -rf "$OBJ_DIR"; then
+                echo "✓ Sucessfully remove $OBJ_DIR "
+            else
+                echo "Warning: Problem encountered while deleting $OBJ_DIR folder, but continuing the process..."
+            fi
+        else
+            echo "Tip: The $OBJ_DIR folder does not exist, no need to clean it up"
+        fi
+
+        # 第一步：使用Verilator编译Verilog代码
+        echo "---------------------------------"
+        echo "Step 1: Run Verilator Compiler..."
+        VERILATOR_OUTPUT=$(verilator "${VERILATOR_ARGS[@]}")
+        VERILATOR_EXIT_CODE=$?
+
+        echo "$VERILATOR_OUTPUT"
+
+        # 检查Verilator是否成功执行
+        if [ ! -f "$OBJ_DIR/VDevelopmentBoard.mk" ]; then
+            echo "Error: Verilator compilation failed!"
+            echo "Possible causes:"
+            echo "1. Not provide correct path of RTLs"
+            echo "2. Verilator is not installed (install command: sudo apt install build-essential verilator)"
+            echo "3. OpenGL/GLUT is not installed (install command: sudo apt install libglu1-mesa-dev freeglut3-dev mesa-common-dev)"
+            echo "4. The code contains syntax errors"
+            exit 1
+        fi
+        echo "$KEY" > "$OBJ_DIR/build.key"
+
+        echo "✓ Verilator compilation completed successfully!"
+    fi
+
+    # 第二步：构建仿真可执行文件 (或插件)，make 只重新编译改动过的文件。
+    # 仿真器库更新后需要重新链接
+    echo "---------------------------------"
+    echo "Step 2: Build the simulation executable..."
+    if [ "$PLUGIN" != "1" ] && [ "$HARNESS_LIB" -nt "$OBJ_DIR/$MODEL_TARGET" ]; then
+        rm -f "$OBJ_DIR/$MODEL_TARGET"
+    fi
+    make -j -C "$OBJ_DIR" -f VDevelopmentBoard.mk "$MODEL_TARGET" \
+        OPT_FAST="$CXX_FLAGS" OPT_SLOW="$CXX_FLAGS" OPT_GLOBAL="$CXX_FLAGS" "${MAKE_ARGS[@]}" $OBJCACHE_FLAG ${CXX:+CXX="$CXX"}
+
+    # 检查make是否成功构建
+    if [ $? -ne 0 ]; then
+        echo "Error: Make build failed!"
+        echo "Please check the compilation error message above"
+        exit 1
+    fi
+
+    echo "✓ Simulation executable file built successfully!"
+}
+
+# 生成模型并构建仿真可执行文件
+if [ "$PROFILE" = "pgo" ]; then
+    # 插桩构建: 编译器 profile，多线程模型还采集 Verilator 的调度 profile
+    rm -rf "$PGO_DIR"
+    VERILATOR_PGO=""
+    if [ "$THREADS" -gt 1 ]; then
+        VERILATOR_PGO="--prof-pgo"
+    fi
+    EXTRA_CXX="-fprofile-generate=$PGO_DIR" build_model $VERILATOR_PGO
+
+    echo "---------------------------------"
+    echo "Run the PGO training workload..."
+    if [ -n "$PGO_WORKLOAD" ]; then
+        WORKLOAD="--replay=$PGO_WORKLOAD"
+    else
+        WORKLOAD="--frames=600"
+    fi
+    "$OBJ_DIR/VDevelopmentBoard" --headless $WORKLOAD "+verilator+prof+vlt+file+$PGO_DIR/profile.vlt"
+    if [ ! -d "$PGO_DIR" ]; then
+        echo "Error: The training run did not write profile data to $PGO_DIR"
+        exit 1
+    fi
+
+    # clang 写出的是 .profraw，-fprofile-use 读取合并后的 default.profdata
+    if compgen -G "$PGO_DIR/*.profraw" > /dev/null; then
+        if ! llvm-profdata merge -o "$PGO_DIR/default.profdata" "$PGO_DIR"/*.profraw; then
+            echo "Error: Cannot merge the profile data (llvm-profdata is needed with clang)"
+            exit 1
+        fi
+    fi
+
+    # 用采集到的 profile 重新构建。-fprofile-partial-training (没跑到的代码仍按普通
+    # 方式优化) 和 -Wno-missing-profile 只有较新的 GCC 支持，先用空程序试编译
+    PGO_USE="-fprofile-use=$PGO_DIR"
+    for FLAG in -fprofile-partial-training -Wno-missing-profile; do
+        if echo "int main() { return 0; }" | ${CXX:-g++} -x c++ -Werror $FLAG -c -o /dev/null - > /dev/null 2>&1; then
+            PGO_USE="$PGO_USE $FLAG"
+        fi
+    done
+    VERILATOR_PGO=""
+    if [ -f "$PGO_DIR/profile.vlt" ]; then
+        VERILATOR_PGO="$PGO_DIR/profile.vlt"
+    fi
+    EXTRA_CXX="$PGO_USE" build_model $VERILATOR_PGO
+else
+    EXTRA_CXX="" build_model
+fi
+
+if [ "$BUILD_ONLY" = "1" ]; then
+    exit 0
+fi
+
+# 第三步：运行仿真
+if [ "$PLUGIN" = "1" ]; then
+    # 'm' 用同样的配置重新运行本脚本构建模型，再加载新的插件
+    SIMULATOR=("$(dirname "$HARNESS_LIB")/vga_sim" --model="$(pwd)/$OBJ_DIR/$MODEL_TARGET"
+        --rebuild="PLUGIN=1 BUILD_ONLY=1 PROFILE=$PROFILE THREADS=$THREADS NO_GL=$NO_GL PIXEL_SINK=${PIXEL_SINK:-1} bash '$HARNESS_DIR/run_simulation.sh' '$DESIGN_DIR' '$INCLUDE_DIR'")
+else
+    SIMULATOR=("$OBJ_DIR/VDevelopmentBoard")
+fi
+echo "---------------------------------"
+echo "Step 3: Start the simulation..."
+echo "----------------------------------------"
+"${SIMULATOR[@]}" "${@:3}"
+
+# 检查仿真是否成功运行
+SIMULATION_EXIT_CODE=$?
+echo "----------------------------------------"
+
+if [ $SIMULATION_EXIT_CODE -ne 0 ]; then
+    echo "WARNING: Simulation execution exit code: $SIMULATION_EXIT_CODE"
+else
+    echo "✓ Simulation execution completed!"
+fi
@@ -0,0 +1,427 @@
+// Adapts a Verilated DevelopmentBoard model to the shared harness. A board
+// project's simulator.cpp describes the board and starts the simulator:
+//
+//     #include "VDevelopmentBoard.h"
+//     #include "vga_board.h"
+//
+//     struct BreakoutBoard {
+//         typedef VDevelopmentBoard Model;
+//         typedef Rgb555 PixelFormat;     // encoding of the rgb port
+//     };
+//
+//     SIM_BOARD_MAIN(BreakoutBoard)
+//
+// SIM_BOARD_MAIN defines main(), or with -DSIM_PLUGIN the entry point of a
+// model plugin for the vga_sim viewer (see vga_plugin.h).
+//
+// The model must have the DevelopmentBoard ports: clk, reset and B2..B5
+// inputs, h_sync, v_sync, rgb[15:0] and led1..led5 outputs. Build with
+// -DSIM_SAVABLE when the model is Verilated with --savable.
+//
+// Pixels are normally scanned from h_sync/v_sync/rgb on every pixel clock,
+// taken to be every CYCLES_PER_PIXEL-th board clock (--pixel-clock-ratio=<n>
+// for other fixed dividers). A board whose pixel clock comes out of a PLL or
+// a divider chain of its own can name that signal in its Traits instead,
+// marked /*verilator public_flat_rd*/ in DevelopmentBoard.v, and is then
+// sampled on its rising edges (rootp is declared in VDevelopmentBoard___024root.h):
+//
+//         static bool pixel_clock(const VDevelopmentBoard& m) {
+//             return m.rootp->DevelopmentBoard__DOT__pixel_clk;
+//         }
+//
+// A VGA timing module Verilated with +define+VGA_PIXEL_SINK (syncGen.v,
+// vga_ctrl.v) reports its active pixels and the end of each frame itself
+// through the DPI-C functions below; the board then stores just those pixels
+// at their exact position and does nothing on blanking cycles.
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "verilated.h"
+#ifdef SIM_SAVABLE
+#include "verilated_save.h"
+#endif
+#include "vga_harness.h"
+
+#ifdef SIM_SAVABLE
+// Verilator save stream into a byte vector
+class MemorySave : public VerilatedSerialize {
+public:
+    explicit MemorySave(std::vector<uint8_t>& out) : out(out) {
+        out.clear();
+        m_isOpen = true;
+        header();
+    }
+    ~MemorySave() override { close(); }
+    void close() override {
+        if (!isOpen()) {
+            return;
+        }
+        trailer();
+        flush();
+        m_isOpen = false;
+    }
+    void flush() override {
+        out.insert(out.end(), m_bufp, m_cp);
+        m_cp = m_bufp;
+    }
+
+private:
+    std::vector<uint8_t>& out;
+};
+
+// Verilator restore stream reading from a byte vector
+class MemoryRestore : public VerilatedDeserialize {
+public:
+    explicit MemoryRestore(const std::vector<uint8_t>& in) : in(in) {
+        m_isOpen = true;
+        m_cp = m_bufp;
+        m_endp = m_bufp;
+        header();
+    }
+    ~MemoryRestore() override { close(); }
+    void close() override {
+        if (!isOpen()) {
+            return;
+        }
+        trailer();
+        m_isOpen = false;
+    }
+
+protected:
+    void fill() override {
+        // keep the unread tail, then append as much of the input as fits
+        size_t left = m_endp - m_cp;
+        memmove(m_bufp, m_cp, left);
+        m_cp = m_bufp;
+        m_endp = m_bufp + left;
+        size_t n = std::min(in.size() - pos, bufferSize() - left);
+        memcpy(m_endp, in.data() + pos, n);
+        pos += n;
+        m_endp += n;
+    }
+
+private:
+    const std::vector<uint8_t>& in;
+    size_t pos = 0;
+};
+#endif // SIM_SAVABLE
+
+// what the model's VGA timing module reported during the last clock edge.
+// It names the pixel the counters have moved to; its colour is on the rgb
+// port once the edge has settled.
+struct PixelReport {
+    bool attached = false;      // the model reports its pixels
+    bool pixel = false;         // (x, y) is on the rgb port
+    bool frame = false;         // the last active line is done
+    int x = 0;
+    int y = 0;
+    int width = 0;              // active size of the frame, with `frame`
+    int height = 0;
+
+    // report of the board being evaluated on this thread, for the DPI functions
+    static inline thread_local PixelReport* current = nullptr;
+};
+
+// DPI-C imports of the VGA timing modules (+define+VGA_PIXEL_SINK). Defined
+// here, vga_board.h is included by the one simulator.cpp of a project.
+extern "C" void vga_sink_attach() {
+    PixelReport::current->attached = true;
+}
+extern "C" void vga_sink_pixel(int x, int y) {
+    PixelReport* report = PixelReport::current;
+    report->pixel = true;
+    report->x = x;
+    report->y = y;
+}
+extern "C" void vga_sink_frame(int width, int height) {
+    PixelReport* report = PixelReport::current;
+    report->frame = true;
+    report->width = width;
+    report->height = height;
+}
+
+// where VerilatedBoard::run() sends the pixels: straight into the harness
+// when the board is linked into the simulator
+struct HarnessSink {
+    static bool sample(bool h_sync, bool v_sync, uint16_t rgb) {
+        return sample_pixel(h_sync, v_sync, rgb);
+    }
+    static void pixel(int x, int y, uint16_t rgb) {
+        store_pixel(x, y, rgb);
+    }
+    static void frame(int width, int height) {
+        complete_frame(width, height);
+    }
+};
+
+// Traits::pixel_clock(const Model&) exists: the board names its pixel clock
+template <class Traits, class = void>
+struct HasPixelClock : std::false_type {};
+template <class Traits>
+struct HasPixelClock<Traits, std::void_t<decltype(Traits::pixel_clock(std::declval<const typename Traits::Model&>()))>>
+    : std::true_type {};
+
+template <class Traits, class Sink = HarnessSink>
+class VerilatedBoard final : public BoardModel {
+public:
+    typedef typename Traits::Model Model;
+
+    VerilatedBoard(int argc, char** argv) : context(new VerilatedContext) {
+        if (argc) {
+            context->commandArgs(argc, argv);   // remember args
+        }
+        PixelReport::current = &report;
+        model.reset(new Model(context.get()));
+    }
+
+    static BoardModel* create(int argc, char** argv) {
+        return new VerilatedBoard(argc, argv);
+    }
+
+    void set_port(int button, uint8_t level) override {
+        switch (button) {
+            case BTN_RESET: model->reset = level; break;
+            case BTN_B2:    model->B2 = level; break;
+            case BTN_B3:    model->B3 = level; break;
+            case BTN_B4:    model->B4 = level; break;
+            case BTN_B5:    model->B5 = level; break;
+        }
+    }
+
+    int leds() override {
+        return (model->led1 ? 1 : 0) | (model->led2 ? 2 : 0) | (model->led3 ? 4 : 0) |
+               (model->led4 ? 8 : 0) | (model->led5 ? 16 : 0);
+    }
+
+    // the first eval() runs the initial blocks, where a timing module
+    // attaches to the pixel sink
+    void clock_low() override {
+        PixelReport::current = &report;
+        model->clk = 0;
+        model->eval();
+    }
+
+    // one board clock period: rising edge, then falling edge
+    void step_clock() override {
+        PixelReport::current = &report;
+        tick();
+        report.pixel = false;
+        report.frame = false;
+    }
+
+    uint64_t run(uint64_t n, bool stop_at_frame) override {
+        PixelReport::current = &report;
+        if (report.attached) {
+            // only the cycles that reach an active pixel or the end of a
+            // frame do any work
+            for (uint64_t i = 0; i < n; i++) {
+                tick();
+                if (report.pixel) {
+                    report.pixel = false;
+                    Sink::pixel(report.x, report.y, model->rgb);
+                }
+                if (report.frame) {
+                    report.frame = false;
+                    Sink::frame(report.width, report.height);
+                    if (stop_at_frame) {
+                        return i + 1;
+                    }
+                }
+            }
+            return n;
+        }
+        for (uint64_t i = 0; i < n; i++) {
+            if (pixel_tick() && Sink::sample(model->h_sync, model->v_sync, model->rgb) && stop_at_frame) {
+                return i + 1;
+            }
+        }
+        return n;
+    }
+
+    bool save(std::vector<uint8_t>& out) override {
+#ifdef SIM_SAVABLE
+        MemorySave os(out);
+        os << *model;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool restore(const std::vector<uint8_t>& in) override {
+#ifdef SIM_SAVABLE
+        MemoryRestore is(in);
+        is >> *model;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool got_finish() override { return context->gotFinish(); }
+    unsigned threads() override { return context->threads(); }
+    void final() override { model->final(); }
+
+private:
+    inline void tick() {
+        time++;
+        model->clk = 1;
+        model->eval();
+
+        // 下降沿
+        time++;
+        model->clk = 0;
+        model->eval();
+    }
+
+    // one board clock period; true if it was a pixel clock: a rising edge
+    // of the pixel clock the Traits name, else every cycles_per_pixel clocks
+    inline bool pixel_tick() {
+        if constexpr (HasPixelClock<Traits>::value) {
+            bool before = Traits::pixel_clock(*model);
+            tick();
+            return !before && Traits::pixel_clock(*model);
+        } else {
+            tick();
+            if (++pixel_phase < cycles_per_pixel) {
+                return false;
+            }
+            pixel_phase = 0;
+            return true;
+        }
+    }
+
+    PixelReport report;
+    // declared first so the model is destroyed before its context
+    std::unique_ptr<VerilatedContext> context;
+    std::unique_ptr<Model> model;
+};
+
+// run the simulator on a board described by Traits
+template <class Traits>
+int run_simulator(int argc, char** argv) {
+    BoardInfo info;
+    info.create = &VerilatedBoard<Traits>::create;
+    info.decode = &Traits::PixelFormat::decode;
+#ifdef SIM_SAVABLE
+    info.savable = true;
+#else
+    info.savable = false;
+#endif
+    info.reload = nullptr;
+    return simulator_main(argc, argv, info);
+}
+
+#ifdef SIM_PLUGIN
+#include "vga_plugin.h"
+
+// pixels of a plugin go to the viewer's callbacks
+struct PluginSink {
+    static inline vga_sample_fn viewer_sample = nullptr;
+    static inline vga_pixel_fn viewer_pixel = nullptr;
+    static inline vga_frame_fn viewer_frame = nullptr;
+    // board being evaluated on this thread, for sc_time_stamp()
+    static inline thread_local BoardModel* current = nullptr;
+
+    static bool sample(bool h_sync, bool v_sync, uint16_t rgb) {
+        return viewer_sample(h_sync, v_sync, rgb) != 0;
+    }
+    static void pixel(int x, int y, uint16_t rgb) {
+        viewer_pixel(x, y, rgb);
+    }
+    static void frame(int width, int height) {
+        viewer_frame(width, height);
+    }
+};
+
+// vga_model_api on top of VerilatedBoard
+template <class Traits>
+struct PluginModel {
+    typedef VerilatedBoard<Traits, PluginSink> Board;
+
+    static Board* board(vga_model* m) { return reinterpret_cast<Board*>(m); }
+
+    static vga_model* create(int argc, char** argv, vga_sample_fn sample,
+                             vga_pixel_fn pixel, vga_frame_fn frame) {
+        PluginSink::viewer_sample = sample;
+        PluginSink::viewer_pixel = pixel;
+        PluginSink::viewer_frame = frame;
+        return reinterpret_cast<vga_model*>(new Board(argc, argv));
+    }
+    static void destroy(vga_model* m) { delete board(m); }
+    static void set_port(vga_model* m, int button, uint8_t level) { board(m)->set_port(button, level); }
+    static int leds(vga_model* m) { return board(m)->leds(); }
+    static void clock_low(vga_model* m) { board(m)->clock_low(); }
+
+    static void step_clock(vga_model* m, uint64_t* time) {
+        Board* b = board(m);
+        PluginSink::current = b;
+        b->time = *time;
+        b->step_clock();
+        *time = b->time;
+    }
+
+    static uint64_t run(vga_model* m, uint64_t* time, int* pixel_phase, int cycles_per_pixel,
+                        uint64_t cycles, int stop_at_frame) {
+        Board* b = board(m);
+        PluginSink::current = b;
+        b->time = *time;
+        b->pixel_phase = *pixel_phase;
+        b->cycles_per_pixel = cycles_per_pixel;
+        uint64_t ran = b->run(cycles, stop_at_frame);
+        *time = b->time;
+        *pixel_phase = b->pixel_phase;
+        return ran;
+    }
+
+    static int save(vga_model* m, vga_write_fn write, void* ctx) {
+        std::vector<uint8_t> out;
+        if (!board(m)->save(out)) {
+            return 0;
+        }
+        write(ctx, out.data(), out.size());
+        return 1;
+    }
+    static int restore(vga_model* m, const uint8_t* data, size_t size) {
+        return board(m)->restore(std::vector<uint8_t>(data, data + size));
+    }
+
+    static int got_finish(vga_model* m) { return board(m)->got_finish(); }
+    static unsigned threads(vga_model* m) { return board(m)->threads(); }
+    static void final(vga_model* m) { board(m)->final(); }
+
+    static const vga_model_api* api() {
+        static const vga_model_api table = {
+            VGA_MODEL_ABI_VERSION,
+#ifdef SIM_SAVABLE
+            1,
+#else
+            0,
+#endif
+            &Traits::PixelFormat::decode,
+            &create, &destroy, &set_port, &leds,
+            &clock_low, &step_clock, &run,
+            &save, &restore,
+            &got_finish, &threads, &final,
+        };
+        return &table;
+    }
+};
+
+#define SIM_BOARD_MAIN(Traits) \
+    double sc_time_stamp() { \
+        return PluginSink::current ? PluginSink::current->time : 0; \
+    } \
+    extern "C" __attribute__((visibility("default"))) const vga_model_api* vga_model_entry(void) { \
+        return PluginModel<Traits>::api(); \
+    }
+#else
+#define SIM_BOARD_MAIN(Traits) \
+    int main(int argc, char** argv) { \
+        return run_simulator<Traits>(argc, argv); \
+    }
+#endif // SIM_PLUGIN
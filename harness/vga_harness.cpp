@@ -0,0 +1,2433 @@
+#ifndef SIM_NO_GL                 // -DSIM_NO_GL builds a headless-only simulator
+#include <GL/freeglut.h>         // freeglut3-dev, for glutSetOption/glutLeaveMainLoop
+#endif
+#include <thread>
+#include <iostream>
+#include <atomic>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <cstdio>
+#include <cmath>
+#include <set>
+#include <sched.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "vga_harness.h"
+
+using namespace std;
+
+// the board being simulated, set up by simulator_main()
+BoardInfo board_info;
+
+// board clocks per pixel clock (--pixel-clock-ratio) for boards that do not
+// name their pixel clock, see BoardModel::cycles_per_pixel
+int pixel_clock_ratio = CYCLES_PER_PIXEL;
+
+// Each sim thread owns one board: the model and the harness state that goes
+// with it are thread_local. Normally that is just the main thread; a
+// --regress run simulates one board per worker thread.
+thread_local BoardModel* board;
+
+double sc_time_stamp() {        // called by $time in Verilog
+    return board ? board->time : 0;
+}
+
+// board clock, one tick() is one period
+const double BOARD_CLOCK_HZ = 50e6;
+
+// keeps the simulation in step with the wall clock. It is consulted once per
+// frame and sleeps off any lead in one go, instead of spinning every cycle.
+//   UNTHROTTLED - run as fast as the host allows
+//   REALTIME    - simulated board time runs at `speed` x wall time
+//   FRAMERATE   - `fps` VGA frames per wall-clock second
+class Pacer {
+public:
+    enum Mode { UNTHROTTLED, REALTIME, FRAMERATE };
+    Mode mode = REALTIME;
+    double speed = 1.0;
+    double fps = 60.0;
+
+    // start a new pacing interval, e.g. after a reset
+    void restart(uint64_t cycles) {
+        base_time = Clock::now();
+        base_cycles = cycles;
+        frames = 0;
+    }
+
+    // called at each frame boundary with the number of board cycles simulated
+    void frame_done(uint64_t cycles) {
+        frames++;
+        if (mode == UNTHROTTLED) {
+            return;
+        }
+        double target = (mode == REALTIME) ? (cycles - base_cycles) / (BOARD_CLOCK_HZ * speed)
+                                           : frames / fps;
+        Clock::time_point deadline = base_time +
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(target));
+        Clock::time_point now = Clock::now();
+        if (deadline > now) {
+            std::this_thread::sleep_until(deadline);
+        } else if (now - deadline > MAX_LAG) {
+            // the host cannot keep up, don't try to catch up in a burst
+            restart(cycles);
+        }
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    const Clock::duration MAX_LAG = std::chrono::milliseconds(100);
+    Clock::time_point base_time = Clock::now();
+    uint64_t base_cycles = 0;
+    uint64_t frames = 0;
+};
+
+thread_local Pacer pacer;
+
+// lock-free ring between exactly one producer thread and one consumer thread
+template <class T, size_t N>
+class SpscQueue {
+    static_assert((N & (N - 1)) == 0, "capacity must be a power of two");
+public:
+    // producer: false if the ring is full and the item was dropped
+    bool push(const T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        items[tail & (N - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer: false if the ring is empty
+    bool pop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[head & (N - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items[N];
+    std::atomic<size_t> head_{0};
+    std::atomic<size_t> tail_{0};
+};
+
+// board clock cycles simulated so far
+inline uint64_t sim_cycles() {
+    return board->time / 2;
+}
+
+// to wait for the graphics thread to complete initialization
+std::atomic<bool> gl_setup_complete(false);
+
+// the largest active area of the supported video modes (see ScanState).
+// Frame buffers hold a frame of any of them with a row stride of MAX_WIDTH.
+const int MAX_WIDTH = 1280;
+const int MAX_HEIGHT = 720;
+
+// size of the frames shown before a video mode has been detected
+const int DEFAULT_WIDTH = 640;
+const int DEFAULT_HEIGHT = 480;
+
+// pixel clocks per frame of 640x480@60, sizes the rewind history
+const int NOMINAL_FRAME_PIXELS = 800 * 525;
+
+// pixels are buffered here, row-major, one packed RGBA8 word per pixel:
+// red in bits 7:0, green in 15:8, blue in 23:16, alpha in 31:24
+const int FRAME_PIXELS = MAX_HEIGHT * MAX_WIDTH;
+
+// frames are triple buffered between the simulation and GLUT threads.
+// The sim thread draws into the back buffer and publishes it once the frame
+// is complete by swapping it into ready_frame; the renderer swaps ready_frame with
+// its front buffer whenever a fresh frame is flagged. Neither side blocks.
+const int FRAME_COUNT = 3;
+const int FRAME_FRESH = 0x4;    // set in ready_frame until the renderer picks it up
+
+// what a board shows: its frames and its LEDs (0 = lit)
+struct BoardOutputs {
+    uint32_t frame_buffers[FRAME_COUNT][FRAME_PIXELS] = {};
+    // active area of each frame, set before the frame is published
+    int frame_width[FRAME_COUNT] = {DEFAULT_WIDTH, DEFAULT_WIDTH, DEFAULT_WIDTH};
+    int frame_height[FRAME_COUNT] = {DEFAULT_HEIGHT, DEFAULT_HEIGHT, DEFAULT_HEIGHT};
+    int back_frame = 0;             // owned by the sim thread
+    std::atomic<int> ready_frame{1};
+    int front_frame = 2;            // owned by the GLUT thread
+    std::atomic<int> leds_state[5] = {{1}, {1}, {1}, {1}, {1}};
+};
+
+// outputs of the board on the main thread, the ones the window displays
+BoardOutputs window_outputs;
+
+// outputs of the board simulated on this thread
+thread_local BoardOutputs* outputs = &window_outputs;
+
+// sim thread: the buffer being drawn
+inline uint32_t* back_buffer() {
+    return outputs->frame_buffers[outputs->back_frame];
+}
+
+// sim thread: hand the finished back buffer, a width x height frame, to the renderer
+void publish_frame(int width, int height) {
+    outputs->frame_width[outputs->back_frame] = width;
+    outputs->frame_height[outputs->back_frame] = height;
+    outputs->back_frame = outputs->ready_frame.exchange(outputs->back_frame | FRAME_FRESH,
+                                                        std::memory_order_acq_rel) & ~FRAME_FRESH;
+}
+
+// GLUT thread: switch to the latest published frame, if there is one
+bool acquire_frame() {
+    BoardOutputs& out = window_outputs;
+    if (!(out.ready_frame.load(std::memory_order_acquire) & FRAME_FRESH)) {
+        return false;
+    }
+    out.front_frame = out.ready_frame.exchange(out.front_frame, std::memory_order_acq_rel) & ~FRAME_FRESH;
+    return true;
+}
+
+// every possible rgb word decoded once up front with the board's
+// PixelFormat, so sampling a pixel is a single table load
+class PixelDecoder {
+public:
+    void init(uint32_t (*decode)(uint16_t)) {
+        for (uint32_t rgb = 0; rgb < 0x10000; rgb++) {
+            table[rgb] = decode(uint16_t(rgb));
+        }
+    }
+    uint32_t operator()(uint16_t rgb) const { return table[rgb]; }
+
+private:
+    uint32_t table[0x10000] = {};
+};
+
+PixelDecoder decode_pixel;
+
+// streams completed frames to a file (or stdout) on a background thread.
+// Frames are copied into a small pool of buffers; the writer hands them back
+// after writing. If the pool is exhausted the frame is dropped rather than
+// making the simulation wait for the disk. The video has the size of the
+// first frame; frames of another video mode are dropped as well.
+//   RAW_RGB - packed 24-bit RGB, e.g. ffmpeg -f rawvideo -pix_fmt rgb24 -s 640x480
+//             (the size is in the report at exit)
+//   Y4M     - YUV4MPEG2, 4:4:4 BT.601 limited range
+class FrameRecorder {
+public:
+    enum Format { RAW_RGB, Y4M };
+
+    ~FrameRecorder() { finish(); }
+
+    // path "-" writes to stdout
+    bool start(const string& path, Format format, int fps) {
+        out = (path == "-") ? stdout : fopen(path.c_str(), "wb");
+        if (!out) {
+            return false;
+        }
+        this->format = format;
+        this->fps = fps;
+        for (int i = 0; i < POOL_SIZE; i++) {
+            pool[i].resize(FRAME_PIXELS);
+            free_buffers.push(i);
+        }
+        running = true;
+        writer = thread(&FrameRecorder::writer_loop, this);
+        return true;
+    }
+
+    bool active() const { return running; }
+
+    // sim thread: queue a copy of a finished width x height frame, never blocks
+    void submit(const uint32_t* frame, int width, int height) {
+        if (!this->width) {
+            this->width = width;
+            this->height = height;
+        }
+        int index;
+        if (width != this->width || height != this->height || !free_buffers.pop(index)) {
+            dropped++;
+            return;
+        }
+        for (int y = 0; y < height; y++) {
+            memcpy(pool[index].data() + y * width, frame + y * MAX_WIDTH, width * sizeof(uint32_t));
+        }
+        full_buffers.push(index);
+    }
+
+    // flush all queued frames and close the output
+    void finish() {
+        if (!running) {
+            return;
+        }
+        running = false;
+        writer.join();
+        if (out != stdout) {
+            fclose(out);
+        } else {
+            fflush(out);
+        }
+    }
+
+    uint64_t frames_written() const { return written; }
+    uint64_t frames_dropped() const { return dropped; }
+    int frame_width() const { return width; }
+    int frame_height() const { return height; }
+
+private:
+    static const int POOL_SIZE = 8;
+
+    void writer_loop() {
+        int index;
+        for (;;) {
+            if (full_buffers.pop(index)) {
+                write_frame(pool[index].data());
+                written++;
+                free_buffers.push(index);
+            } else if (!running) {
+                break;
+            } else {
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+        }
+    }
+
+    // frame holds width x height pixels, the size of the video
+    void write_frame(const uint32_t* frame) {
+        int pixels = width * height;
+        if (format == RAW_RGB) {
+            for (int i = 0; i < pixels; i++) {
+                line[i * 3 + 0] = rgba_r(frame[i]);
+                line[i * 3 + 1] = rgba_g(frame[i]);
+                line[i * 3 + 2] = rgba_b(frame[i]);
+            }
+            fwrite(line.data(), 1, pixels * 3, out);
+        } else {
+            if (!written) {
+                fprintf(out, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, fps);
+            }
+            uint8_t* y = line.data();
+            uint8_t* u = y + pixels;
+            uint8_t* v = u + pixels;
+            for (int i = 0; i < pixels; i++) {
+                int r = rgba_r(frame[i]), g = rgba_g(frame[i]), b = rgba_b(frame[i]);
+                y[i] = uint8_t((( 66 * r + 129 * g +  25 * b + 128) >> 8) + 16);
+                u[i] = uint8_t(((-38 * r -  74 * g + 112 * b + 128) >> 8) + 128);
+                v[i] = uint8_t(((112 * r -  94 * g -  18 * b + 128) >> 8) + 128);
+            }
+            fputs("FRAME\n", out);
+            fwrite(line.data(), 1, pixels * 3, out);
+        }
+    }
+
+    FILE* out = nullptr;
+    Format format = RAW_RGB;
+    int fps = 60;
+    int width = 0;          // set by the first frame, before the writer sees it
+    int height = 0;
+    thread writer;
+    std::atomic<bool> running{false};
+    std::vector<uint32_t> pool[POOL_SIZE] = {};
+    std::vector<uint8_t> line = std::vector<uint8_t>(FRAME_PIXELS * 3);
+    SpscQueue<int, POOL_SIZE> free_buffers;     // writer -> sim thread
+    SpscQueue<int, POOL_SIZE> full_buffers;     // sim thread -> writer
+    uint64_t dropped = 0;
+    std::atomic<uint64_t> written{0};
+};
+
+FrameRecorder recorder;
+
+// how the VGA area is presented:
+//   PRESENT_TEXTURE - upload the frame as one texture and draw a single quad
+//   PRESENT_RECTS   - one immediate-mode glRectf per pixel (slow fallback for
+//                     GL implementations with broken texture support)
+enum PresentMode { PRESENT_TEXTURE, PRESENT_RECTS };
+std::atomic<int> present_mode(PRESENT_TEXTURE);
+
+// set when the GLUT window has been closed
+std::atomic<bool> window_closed(false);
+
+// set by the sim thread when the simulation is over, makes the GLUT thread
+// return from glutMainLoop()
+std::atomic<bool> gl_shutdown(false);
+
+// harness actions that travel the same way as button changes, so they are
+// logged and replayed in order with them:
+//   ACT_RESTART   - 'a', back to the power-on state
+//   ACT_QUICKSAVE - 'k', snapshot into the quick save slot
+//   ACT_QUICKLOAD - 'l', restore the quick save slot
+enum Action { ACT_RESTART = BUTTON_COUNT, ACT_QUICKSAVE, ACT_QUICKLOAD };
+
+// one button change or action. cycle is filled in by the sim thread with the
+// number of board cycles simulated when it took effect (monotonic across
+// restarts and snapshot loads), so the applied events form an exact input log
+struct InputEvent {
+    uint64_t cycle;
+    uint8_t button;     // Button or Action
+    uint8_t level;      // port level, buttons are active low
+};
+
+// key events travel from the GLUT thread to the sim thread through this ring
+SpscQueue<InputEvent, 256> input_queue;
+
+// board cycles simulated since start-up; unlike sim_cycles() this never
+// goes back when a snapshot is restored
+thread_local uint64_t cycles_simulated = 0;
+
+// the sim thread drains input_queue once per this many board cycles
+const uint64_t INPUT_BATCH_CYCLES = 1024;
+
+// replay seek target in frames, -1 when none is pending. Typed as digits
+// followed by 'j' in the window, picked up by the sim thread between batches.
+std::atomic<int64_t> seek_request(-1);
+
+// 'r' is held down, the sim thread steps back one frame per frame period
+std::atomic<bool> rewind_held(false);
+
+// 'm' was pressed: the sim thread rebuilds and swaps in the model plugin
+std::atomic<bool> reload_request(false);
+
+// keyboard mapping of the board buttons, -1 for other keys
+int key_button(unsigned char key) {
+    switch(key) {
+        case 'a': return BTN_RESET;
+        case 's': return BTN_B2;
+        case 'd': return BTN_B3;
+        case 'f': return BTN_B4;
+        case 'g': return BTN_B5;
+    }
+    return -1;
+}
+
+#ifndef SIM_NO_GL
+// calculating each pixel's size in accordance to OpenGL system
+// each axis in OpenGL is in the range [-1:1]
+// 重新计算VGA像素大小，保持原始比例
+float pixel_w = 2.0 / DEFAULT_WIDTH * 0.8f;
+float pixel_h = 2.0 / DEFAULT_HEIGHT * 0.8f;
+
+// corners of the 4:3 VGA area on screen, same mapping as the per-pixel rectangles
+const float VGA_LEFT   = (0 * pixel_w - 0.8f) * 0.8f;
+const float VGA_RIGHT  = (DEFAULT_WIDTH * pixel_w - 0.8f) * 0.8f;
+const float VGA_TOP    = (0 * pixel_h + 0.6f) * 0.8f + 0.3f;
+const float VGA_BOTTOM = (-DEFAULT_HEIGHT * pixel_h + 0.6f) * 0.8f + 0.3f;
+
+// where a width x height frame goes: the full width of the VGA area, and
+// for wider modes (16:9) only as much of its height as keeps the aspect
+void frame_quad(int width, int height, float& right, float& bottom) {
+    right = VGA_RIGHT;
+    bottom = VGA_BOTTOM;
+    if (width * 3 > height * 4) {
+        bottom = VGA_TOP - (VGA_TOP - VGA_BOTTOM) * (height * 4.0f) / (width * 3.0f);
+    }
+}
+
+GLuint vga_texture = 0;
+
+const int WINDOW_WIDTH = 800;  // 窗口宽度
+const int WINDOW_HEIGHT = 600; // 窗口高度
+const int VGA_DISPLAY_HEIGHT = 480; // VGA显示区域高度
+const int LED_DISPLAY_HEIGHT = 100; // LED显示区域高度
+
+// 添加圆形绘制函数
+void drawCircle(float cx, float cy, float r, int num_segments) {
+    glBegin(GL_TRIANGLE_FAN);
+    for(int i = 0; i < num_segments; i++) {
+        float theta = 2.0f * 3.1415926f * float(i) / float(num_segments);
+        float x = r * cosf(theta);
+        float y = r * sinf(theta);
+        glVertex2f(x + cx, y + cy);
+    }
+    glEnd();
+}
+
+// allocate the texture backing the VGA area, must run on the GL thread
+void init_vga_texture() {
+    glGenTextures(1, &vga_texture);
+    glBindTexture(GL_TEXTURE_2D, vga_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, MAX_WIDTH, MAX_HEIGHT, 0,
+                 GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// draw the VGA area as a single textured quad
+void render_vga_texture() {
+    const BoardOutputs& out = window_outputs;
+    int width = out.frame_width[out.front_frame];
+    int height = out.frame_height[out.front_frame];
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, vga_texture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, MAX_WIDTH);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height,
+                    GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV, out.frame_buffers[out.front_frame]);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    // texture row 0 is the top VGA line; the frame fills the top-left corner
+    float s = float(width) / MAX_WIDTH;
+    float t = float(height) / MAX_HEIGHT;
+    float right, bottom;
+    frame_quad(width, height, right, bottom);
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.0f, 0.0f); glVertex2f(VGA_LEFT, VGA_TOP);
+    glTexCoord2f(s, 0.0f); glVertex2f(right, VGA_TOP);
+    glTexCoord2f(s, t); glVertex2f(right, bottom);
+    glTexCoord2f(0.0f, t); glVertex2f(VGA_LEFT, bottom);
+    glEnd();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDisable(GL_TEXTURE_2D);
+}
+
+// draw the VGA area with one rectangle per pixel
+void render_vga_rects() {
+    const BoardOutputs& out = window_outputs;
+    const uint32_t* frame = out.frame_buffers[out.front_frame];
+    int width = out.frame_width[out.front_frame];
+    int height = out.frame_height[out.front_frame];
+    float right, bottom;
+    frame_quad(width, height, right, bottom);
+    float w = (right - VGA_LEFT) / width;
+    float h = (VGA_TOP - bottom) / height;
+    for(int j = 0; j < height; j++){
+        for(int i = 0; i < width; i++){
+            uint32_t pixel = frame[j * MAX_WIDTH + i];
+            glColor3ub(rgba_r(pixel), rgba_g(pixel), rgba_b(pixel));
+            // 调整VGA显示位置，使其位于VGA区域中心
+            float x1 = VGA_LEFT + i * w;
+            float y1 = VGA_TOP - j * h;
+            glRectf(x1, y1, x1 + w, y1 - h);
+        }
+    }
+}
+
+// gets called periodically to update screen
+void render(void) {
+    acquire_frame();
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // 绘制VGA显示区域背景
+    glColor3f(0.1f, 0.1f, 0.1f);
+    glRectf(-1.0f, -1.0f, 1.0f, 1.0f);
+
+    // 绘制VGA显示区域标题
+    glColor3f(1.0f, 1.0f, 1.0f);
+    glRasterPos2f(-0.9f, 0.9f);
+    std::string vga_title = "VGA screen";
+    for (char c : vga_title) {
+        glutBitmapCharacter(GLUT_BITMAP_9_BY_15, c);
+    }
+    
+    if(present_mode == PRESENT_TEXTURE){
+        render_vga_texture();
+    } else {
+        render_vga_rects();
+    }
+
+    // 绘制LED显示区域背景
+    glColor3f(0.2f, 0.2f, 0.2f);
+    glRectf(-1.0f, -1.0f, 1.0f, -0.8f);
+
+    // 绘制LED显示区域标题
+    glColor3f(1.0f, 1.0f, 1.0f);
+    glRasterPos2f(-0.9f, -0.85f);
+    std::string led_title = "LED";
+    for (char c : led_title) {
+        glutBitmapCharacter(GLUT_BITMAP_9_BY_15, c);
+    }
+
+    // 绘制LED
+    float led_spacing = 1.6f / 6.0f; // LED之间的间距
+    float led_radius = 0.04f;        // LED半径
+    
+    for(int i = 0; i < 5; i++){
+        float x_pos = -0.8f + (i+1) * led_spacing;
+        float y_pos = -0.9f;
+        
+        // 绘制LED底座
+        glColor3f(0.3f, 0.3f, 0.3f);
+        drawCircle(x_pos, y_pos, led_radius * 1.2f, 20);
+        
+        // 根据状态绘制LED
+        if(window_outputs.leds_state[i] == 0){
+            // LED亮
+            glColor3f(1.0f, 0.0f, 0.0f); // 红色
+        } else {
+            // LED灭
+            glColor3f(0.1f, 0.0f, 0.0f); // 暗红色
+        }
+        drawCircle(x_pos, y_pos, led_radius, 20);
+        
+        // 绘制LED编号
+        glColor3f(1.0f, 1.0f, 1.0f);
+        glRasterPos2f(x_pos - 0.01f, y_pos - 0.06f);
+        glutBitmapCharacter(GLUT_BITMAP_9_BY_15, '1' + i);
+    }
+    
+    glFlush();
+}
+
+
+
+// LED states at the last redraw, one bit per LED
+int shown_leds = -1;
+
+int current_leds() {
+    int bits = 0;
+    for (int i = 0; i < 5; i++) {
+        bits |= (window_outputs.leds_state[i] ? 1 : 0) << i;
+    }
+    return bits;
+}
+
+// timer to periodically update the screen, only redraws when the simulation
+// has published a new frame or an LED changed
+void glutTimer(int t) {
+    if (gl_shutdown) {
+        glutLeaveMainLoop();
+        return;
+    }
+    int leds = current_leds();
+    if ((window_outputs.ready_frame.load(std::memory_order_acquire) & FRAME_FRESH) || leds != shown_leds) {
+        shown_leds = leds;
+        glutPostRedisplay(); // re-renders the screen
+    }
+    glutTimerFunc(t, glutTimer, t);
+}
+
+// frame number being typed for 'j', -1 if none
+int64_t seek_digits = -1;
+
+void keyPressed(unsigned char key, int x, int y) {
+    int button = key_button(key);
+    switch(key) {
+        case 'a':
+            // restart instead of pressing the reset button
+            button = ACT_RESTART;
+            break;
+        case 'k':
+            button = ACT_QUICKSAVE;
+            break;
+        case 'l':
+            button = ACT_QUICKLOAD;
+            break;
+        case 'p':
+            // switch between texture and per-pixel rectangle presentation
+            present_mode = (present_mode == PRESENT_TEXTURE) ? PRESENT_RECTS : PRESENT_TEXTURE;
+            glutPostRedisplay();
+            break;
+        case 'r':
+            rewind_held = true;
+            break;
+        case 'm':
+            reload_request = true;
+            break;
+        case 'j':
+            // jump to the frame number typed before it (replay only)
+            if (seek_digits >= 0) {
+                seek_request = seek_digits;
+            }
+            seek_digits = -1;
+            break;
+    }
+    if (key >= '0' && key <= '9') {
+        seek_digits = max<int64_t>(seek_digits, 0) * 10 + (key - '0');
+    }
+    if (button >= 0) {
+        input_queue.push(InputEvent{0, uint8_t(button), 0});
+    }
+}
+void keyReleased(unsigned char key, int x, int y) {
+    int button = key_button(key);
+    if (key == 'r') {
+        rewind_held = false;
+    }
+    if (button >= 0) {
+        input_queue.push(InputEvent{0, uint8_t(button), 1});
+    }
+}
+
+// initiate and handle graphics
+void graphics_loop(int argc, char** argv) {
+    glutInit(&argc, argv);
+    glutInitDisplayMode(GLUT_SINGLE);
+    glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
+    glutInitWindowPosition(100, 100);
+    glutCreateWindow("VGA and LED Simulator");
+    glutDisplayFunc(render);
+    glutSetKeyRepeat(GLUT_KEY_REPEAT_OFF);
+    glutKeyboardFunc(keyPressed);
+    glutKeyboardUpFunc(keyReleased);
+    init_vga_texture();
+    
+    gl_setup_complete = true;
+
+    // re-render every 16ms, around 60Hz
+    glutTimerFunc(16, glutTimer, 16);
+    // return from glutMainLoop() on close so main() can shut down cleanly
+    glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
+    glutMainLoop();
+    window_closed = true;
+}
+#endif // SIM_NO_GL
+
+// owns the GLUT thread; stop() (also run on destruction, e.g. on an early
+// error return) makes it leave glutMainLoop() and waits for it
+class GraphicsThread {
+public:
+    ~GraphicsThread() { stop(); }
+
+#ifndef SIM_NO_GL
+    void start(int argc, char** argv) {
+        gl = thread(graphics_loop, argc, argv);
+    }
+#endif
+
+    void stop() {
+        if (gl.joinable()) {
+#ifndef SIM_NO_GL
+            gl_shutdown = true;
+#endif
+            gl.join();
+        }
+    }
+
+private:
+    thread gl;
+};
+
+// frames completed: frame_count is part of the snapshot state and follows
+// restores, frames_simulated only ever counts up
+thread_local uint64_t frame_count = 0;
+thread_local uint64_t frames_simulated = 0;
+
+// Scanout of the VGA signals (sample_pixel()). The timing is not fixed: it
+// is measured from h_sync/v_sync and the picture itself, then a per-mode
+// scanline state machine takes over.
+//   SCAN_SEEK     - time one full pulse and gap of each sync signal: their
+//                   polarities, h/v totals and sync widths
+//   SCAN_MEASURE  - from the next v_sync pulse on, DETECT_FRAMES frames
+//                   counting lines and recording where the picture is lit
+//   SCAN_LOCKED   - each line is sync, back porch, active, front porch; only
+//                   active pixels are decoded and stored, and a sync level out
+//                   of place goes back to SCAN_SEEK
+// Positions count from the start of the sync pulses: x in pixel clocks since
+// the h_sync pulse began, lines since the line in which the v_sync pulse
+// began. Plain ints only, the state is copied into snapshots byte for byte.
+enum ScanPhase { SCAN_SEEK, SCAN_MEASURE, SCAN_LOCKED };
+enum ScanSegment { SEG_SYNC, SEG_BACK_PORCH, SEG_ACTIVE, SEG_FRONT_PORCH, SEG_COUNT };
+
+const int DETECT_FRAMES = 2;
+
+struct ScanState {
+    int32_t phase = SCAN_SEEK;
+    int32_t pre_h_sync = 0;
+    int32_t pre_v_sync = 0;
+
+    // SCAN_SEEK: length of the run in progress (0 until the first edge) and
+    // of the last complete run at each level, in pixel clocks
+    int32_t h_run = 0;
+    int32_t v_run = 0;
+    int32_t h_runs[2] = {0, 0};
+    int32_t v_runs[2] = {0, 0};
+
+    // the timing; the active window is known once locked
+    int32_t h_pulse = 0;            // level of h_sync during its pulse
+    int32_t v_pulse = 0;
+    int32_t h_total = 0;
+    int32_t h_sync = 0;
+    int32_t v_total = 0;            // lines
+    int32_t v_sync = 0;             // pixel clocks while measuring, lines once locked
+    int32_t h_start = 0;            // first active pixel after the h_sync pulse began
+    int32_t v_start = 0;            // first active line
+    int32_t width = 0;
+    int32_t height = 0;
+
+    // position (SCAN_MEASURE, SCAN_LOCKED)
+    int32_t x = 0;
+    int32_t line = 0;
+
+    // SCAN_MEASURE: frames measured, extent of the lit pixels of the current
+    // line, and of the frame over the lines that are dark during h_sync
+    int32_t frames = 0;
+    int32_t line_lo = 0;
+    int32_t line_hi = -1;
+    int32_t line_lit_in_sync = 0;
+    int32_t lit_x0 = 0;
+    int32_t lit_x1 = -1;
+    int32_t lit_y0 = 0;
+    int32_t lit_y1 = -1;
+
+    // SCAN_LOCKED: current segment of the line, pixel clocks left in it,
+    // length of each segment, and the frame buffer index of the next active
+    // pixel (-1 on lines outside the active window)
+    int32_t segment = SEG_SYNC;
+    int32_t left = 0;
+    int32_t segment_length[SEG_COUNT] = {0, 0, 0, 0};
+    int32_t pixel = -1;
+};
+
+thread_local ScanState scan;
+
+// current level of each button port, only touched by the sim thread
+thread_local uint8_t port_levels[BUTTON_COUNT] = {1, 1, 1, 1, 1};
+
+// drive one button port of the model
+void set_port(int button, uint8_t level) {
+    port_levels[button] = level;
+    board->set_port(button, level);
+}
+
+void update_leds(){
+    // 更新LED状态
+    int bits = board->leds();
+    for (int i = 0; i < 5; i++) {
+        outputs->leds_state[i] = (bits >> i) & 1;
+    }
+}
+
+// simulate for a single clock
+void tick() {
+    board->step_clock();
+    update_leds();
+}
+
+// drop the key events queued so far, they belong to the previous run.
+// input_queue has a single consumer, the sim thread of the window: only the
+// interactive paths call this, never the --regress workers.
+void discard_input() {
+    InputEvent stale;
+    while (input_queue.pop(stale)) {}
+}
+
+// globally reset the model
+void reset() {
+    // 按下复位，其余按键松开
+    set_port(BTN_RESET, 0);
+    for (int i = BTN_B2; i < BUTTON_COUNT; i++) {
+        set_port(i, 1);
+    }
+    board->clock_low();
+    // 执行多个时钟周期确保完全复位
+    for(int i = 0; i < 10; i++) {
+        tick();
+    }
+    set_port(BTN_RESET, 1);
+
+    // 重置图形缓冲区: publish a black frame, then clear the new back buffer
+    std::fill(back_buffer(), back_buffer() + FRAME_PIXELS, pack_rgba(0, 0, 0));
+    publish_frame(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+    std::fill(back_buffer(), back_buffer() + FRAME_PIXELS, pack_rgba(0, 0, 0));
+
+    // 重置VGA信号跟踪变量: the video mode is detected again
+    scan = ScanState();
+    board->pixel_phase = 0;
+
+    pacer.restart(sim_cycles());
+}
+
+// complete simulator state: the Verilated model plus the scanout state of
+// the harness, including the partially drawn back buffer
+struct Snapshot {
+    std::vector<uint8_t> model;     // serialized with Verilator --savable
+    uint64_t main_time = 0;
+    uint64_t frame_count = 0;
+    ScanState scan;
+    int pixel_phase = 0;
+    uint8_t port_levels[BUTTON_COUNT] = {};
+    std::vector<uint32_t> frame;
+
+    bool valid() const { return !model.empty(); }
+};
+
+// true if this build can take snapshots of the model
+bool snapshots_supported() {
+    return board_info.savable;
+}
+
+// capture the current simulator state. Without the back buffer (with_frame
+// false) the snapshot is only a few KB and is only good for restoring at a
+// frame boundary, where the back buffer is about to be redrawn anyway.
+void save_snapshot(Snapshot& snap, bool with_frame = true) {
+    if (!board->save(snap.model)) {
+        snap.model.clear();
+    }
+    snap.main_time = board->time;
+    snap.frame_count = frame_count;
+    snap.scan = scan;
+    snap.pixel_phase = board->pixel_phase;
+    memcpy(snap.port_levels, port_levels, sizeof(port_levels));
+    if (with_frame) {
+        snap.frame.assign(back_buffer(), back_buffer() + FRAME_PIXELS);
+    } else {
+        snap.frame.clear();
+    }
+}
+
+// return the simulator to a captured state
+void restore_snapshot(const Snapshot& snap) {
+    board->restore(snap.model);
+    board->time = snap.main_time;
+    frame_count = snap.frame_count;
+    scan = snap.scan;
+    board->pixel_phase = snap.pixel_phase;
+    memcpy(port_levels, snap.port_levels, sizeof(port_levels));
+    if (!snap.frame.empty()) {
+        memcpy(back_buffer(), snap.frame.data(), FRAME_PIXELS * sizeof(uint32_t));
+    }
+    update_leds();
+    pacer.restart(sim_cycles());
+}
+
+// append raw bytes to a byte vector
+inline void put_bytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), p, p + size);
+}
+
+// bounds-checked cursor over a byte buffer
+struct ByteReader {
+    const uint8_t* p;
+    const uint8_t* end;
+
+    bool get(void* data, size_t size) {
+        if (size_t(end - p) < size) {
+            return false;
+        }
+        memcpy(data, p, size);
+        p += size;
+        return true;
+    }
+};
+
+// snapshot layout: magic, the fixed-size fields in declaration order, then
+// the model blob and the back buffer (possibly empty), each prefixed by its size
+const char SNAPSHOT_MAGIC[8] = {'V', 'G', 'A', 'S', 'N', 'A', 'P', '2'};
+
+// append the encoded snapshot to out
+void encode_snapshot(const Snapshot& snap, std::vector<uint8_t>& out) {
+    uint64_t model_size = snap.model.size();
+    uint64_t frame_size = snap.frame.size();
+    put_bytes(out, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    put_bytes(out, &snap.main_time, sizeof(snap.main_time));
+    put_bytes(out, &snap.frame_count, sizeof(snap.frame_count));
+    put_bytes(out, &snap.scan, sizeof(snap.scan));
+    put_bytes(out, &snap.pixel_phase, sizeof(snap.pixel_phase));
+    put_bytes(out, snap.port_levels, sizeof(snap.port_levels));
+    put_bytes(out, &model_size, sizeof(model_size));
+    put_bytes(out, snap.model.data(), model_size);
+    put_bytes(out, &frame_size, sizeof(frame_size));
+    put_bytes(out, snap.frame.data(), frame_size * sizeof(uint32_t));
+}
+
+// decode one snapshot at the reader position
+bool decode_snapshot(Snapshot& snap, ByteReader& r) {
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    uint64_t model_size = 0;
+    uint64_t frame_size = 0;
+    bool ok = r.get(magic, sizeof(magic)) &&
+              memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0 &&
+              r.get(&snap.main_time, sizeof(snap.main_time)) &&
+              r.get(&snap.frame_count, sizeof(snap.frame_count)) &&
+              r.get(&snap.scan, sizeof(snap.scan)) &&
+              r.get(&snap.pixel_phase, sizeof(snap.pixel_phase)) &&
+              r.get(snap.port_levels, sizeof(snap.port_levels)) &&
+              r.get(&model_size, sizeof(model_size)) &&
+              model_size <= size_t(r.end - r.p);
+    if (ok) {
+        snap.model.resize(model_size);
+        ok = r.get(snap.model.data(), model_size) &&
+             r.get(&frame_size, sizeof(frame_size)) &&
+             (frame_size == 0 || frame_size == FRAME_PIXELS);
+    }
+    if (ok) {
+        snap.frame.resize(frame_size);
+        ok = r.get(snap.frame.data(), frame_size * sizeof(uint32_t));
+    }
+    return ok;
+}
+
+void put_varint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(uint8_t(v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(uint8_t(v));
+}
+
+bool get_varint(ByteReader& r, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && r.p != r.end; shift += 7) {
+        uint8_t c = *r.p++;
+        v |= uint64_t(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Rewind history of frame-boundary states. The newest encoded state is kept
+// in full; each older one is stored as its XOR with the state after it,
+// coded as (unchanged byte run, changed byte run, changed bytes) triples.
+// Consecutive frames differ in a few registers, so a delta is tens of bytes.
+class RewindBuffer {
+public:
+    // keep at most `frames` states, 0 disables the history
+    void reset(size_t frames) {
+        capacity = frames;
+        head.clear();
+        deltas.clear();
+    }
+
+    // drop the states but keep the capacity
+    void clear() {
+        head.clear();
+        deltas.clear();
+    }
+
+    // keep at most `frames` states from now on, dropping the oldest ones
+    // that no longer fit
+    void set_capacity(size_t frames) {
+        capacity = frames;
+        while (!deltas.empty() && deltas.size() >= capacity) {
+            deltas.pop_front();
+        }
+    }
+
+    bool enabled() const { return capacity > 0; }
+    size_t size() const { return head.empty() ? 0 : deltas.size() + 1; }
+    const std::vector<uint8_t>& newest() const { return head; }
+
+    void push(const std::vector<uint8_t>& state) {
+        if (!head.empty()) {
+            deltas.emplace_back();
+            encode_delta(state, head, deltas.back());
+            if (deltas.size() >= capacity) {
+                deltas.pop_front();
+            }
+        }
+        head = state;
+    }
+
+    // drop the newest state, the one before it becomes the newest
+    bool pop() {
+        if (deltas.empty()) {
+            return false;
+        }
+        std::vector<uint8_t> older;
+        if (!decode_delta(head, deltas.back(), older)) {
+            return false;
+        }
+        head.swap(older);
+        deltas.pop_back();
+        return true;
+    }
+
+private:
+    static uint8_t byte_at(const std::vector<uint8_t>& v, size_t i) {
+        return i < v.size() ? v[i] : 0;
+    }
+
+    // describe `older` relative to `newer`
+    static void encode_delta(const std::vector<uint8_t>& newer, const std::vector<uint8_t>& older,
+                             std::vector<uint8_t>& out) {
+        put_varint(out, older.size());
+        size_t i = 0;
+        while (i < older.size()) {
+            size_t same = i;
+            while (i < older.size() && older[i] == byte_at(newer, i)) {
+                i++;
+            }
+            size_t changed = i;
+            while (i < older.size() && older[i] != byte_at(newer, i)) {
+                i++;
+            }
+            put_varint(out, changed - same);
+            put_varint(out, i - changed);
+            for (size_t j = changed; j < i; j++) {
+                out.push_back(older[j] ^ byte_at(newer, j));
+            }
+        }
+    }
+
+    static bool decode_delta(const std::vector<uint8_t>& newer, const std::vector<uint8_t>& delta,
+                             std::vector<uint8_t>& older) {
+        ByteReader r{delta.data(), delta.data() + delta.size()};
+        uint64_t size, same, changed;
+        if (!get_varint(r, size)) {
+            return false;
+        }
+        older.resize(size);
+        size_t i = 0;
+        while (i < size) {
+            if (!get_varint(r, same) || !get_varint(r, changed) ||
+                same + changed > size - i || changed > size_t(r.end - r.p)) {
+                return false;
+            }
+            for (uint64_t j = 0; j < same; j++, i++) {
+                older[i] = byte_at(newer, i);
+            }
+            for (uint64_t j = 0; j < changed; j++, i++) {
+                older[i] = *r.p++ ^ byte_at(newer, i);
+            }
+        }
+        return true;
+    }
+
+    size_t capacity = 0;
+    std::vector<uint8_t> head;
+    std::deque<std::vector<uint8_t>> deltas;    // deltas.back() turns head into the state before it
+};
+
+RewindBuffer rewind_history;
+
+// frames in `seconds` of board time. A frame lasts the detected video mode's
+// total size at the board's cycles per pixel; models that report their own
+// pixels never lock a mode and use the measured length of the last frame
+// (measured_cycles, 0 if none yet), and until either is known 640x480@60 at
+// the board's cycles per pixel is assumed.
+size_t rewind_capacity(double seconds, uint64_t measured_cycles) {
+    uint64_t frame_cycles;
+    if (scan.phase == SCAN_LOCKED) {
+        frame_cycles = uint64_t(scan.h_total) * scan.v_total * board->cycles_per_pixel;
+    } else if (measured_cycles) {
+        frame_cycles = measured_cycles;
+    } else {
+        frame_cycles = uint64_t(NOMINAL_FRAME_PIXELS) * board->cycles_per_pixel;
+    }
+    return max<size_t>(1, size_t(seconds * BOARD_CLOCK_HZ / frame_cycles));
+}
+
+// add the state at this frame boundary to the rewind history
+void push_rewind_state() {
+    static Snapshot state;
+    static std::vector<uint8_t> encoded;
+    save_snapshot(state, false);
+    encoded.clear();
+    encode_snapshot(state, encoded);
+    rewind_history.push(encoded);
+}
+
+// go back one frame: drop the current and the previous frame-boundary state,
+// restore the one before those and simulate a frame to redraw the picture.
+// That frame pushes the previous state back onto the history.
+bool rewind_frame() {
+    if (rewind_history.size() < 3 || !rewind_history.pop() || !rewind_history.pop()) {
+        return false;
+    }
+    Snapshot state;
+    ByteReader r{rewind_history.newest().data(), rewind_history.newest().data() + rewind_history.newest().size()};
+    if (!decode_snapshot(state, r)) {
+        return false;
+    }
+    restore_snapshot(state);
+    return true;
+}
+
+// read a whole file into memory
+bool read_file(const string& path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    data.clear();
+    uint8_t chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+bool write_snapshot(const Snapshot& snap, const string& path) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    std::vector<uint8_t> data;
+    encode_snapshot(snap, data);
+    bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+    return (fclose(f) == 0) && ok;
+}
+
+bool read_snapshot(Snapshot& snap, const string& path) {
+    std::vector<uint8_t> data;
+    if (!read_file(path, data)) {
+        return false;
+    }
+    ByteReader r{data.data(), data.data() + data.size()};
+    return decode_snapshot(snap, r);
+}
+
+// FNV-1a over a width x height frame, used to check that a replay ends on
+// the same picture
+uint64_t hash_frame(const uint32_t* frame, int width, int height) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            hash = (hash ^ frame[y * MAX_WIDTH + x]) * 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+// hash of the last published frame, only maintained while recording or
+// replaying input
+thread_local bool hash_frames = false;
+thread_local uint64_t last_frame_hash = 0;
+
+// Input log file. Numbers are LEB128 varints unless noted.
+//   header    magic, sim_cycles() at the start of the session, keyframe interval
+//   chunks    'E' cycle delta to the previous event, (button << 1 | level) byte
+//             'K' frames, cycles and events so far, snapshot size, snapshot
+//             'X' total cycles, total frames, hash of the last frame (8 bytes)
+//   index     keyframe count, then per keyframe: frames, cycles, events so
+//             far, file offset of its 'K' chunk
+//   footer    file offset of the index (8 bytes)
+// Keyframes are frame-boundary snapshots taken every `interval` frames, so
+// seeking to any frame re-simulates at most `interval` frames.
+const char INPUT_LOG_MAGIC[8] = {'V', 'G', 'A', 'I', 'N', 'P', 'T', '2'};
+
+void put_varint(FILE* f, uint64_t v) {
+    while (v >= 0x80) {
+        fputc(int(v & 0x7F) | 0x80, f);
+        v >>= 7;
+    }
+    fputc(int(v), f);
+}
+
+bool get_varint(FILE* f, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = fgetc(f);
+        if (c == EOF) {
+            return false;
+        }
+        v |= uint64_t(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// keyframe position in the input log
+struct Keyframe {
+    uint64_t frames;        // frames_simulated when it was taken
+    uint64_t cycles;        // cycles_simulated when it was taken
+    uint64_t events;        // events logged before it
+    uint64_t offset;        // file offset of the 'K' chunk
+};
+
+// streams an input log to disk while the session runs
+class InputLogWriter {
+public:
+    ~InputLogWriter() {
+        if (f) {
+            fclose(f);
+        }
+    }
+
+    bool open(const string& path, uint64_t start_cycle, uint64_t interval) {
+        f = fopen(path.c_str(), "wb");
+        if (!f) {
+            return false;
+        }
+        fwrite(INPUT_LOG_MAGIC, 1, sizeof(INPUT_LOG_MAGIC), f);
+        put_varint(f, start_cycle);
+        put_varint(f, interval);
+        keyframe_interval = interval;
+        return true;
+    }
+
+    bool is_open() const { return f != nullptr; }
+    uint64_t interval() const { return keyframe_interval; }
+
+    void event(const InputEvent& event) {
+        fputc('E', f);
+        put_varint(f, event.cycle - last_cycle);
+        fputc((event.button << 1) | (event.level & 1), f);
+        last_cycle = event.cycle;
+        events++;
+    }
+
+    // the quick save slot goes along with the state, a later quick load may
+    // refer to it
+    void keyframe(const Snapshot& snap, const Snapshot& quicksave, uint64_t frames, uint64_t cycles) {
+        buffer.clear();
+        encode_snapshot(snap, buffer);
+        if (quicksave.valid()) {
+            encode_snapshot(quicksave, buffer);
+        }
+        index.push_back(Keyframe{frames, cycles, events, uint64_t(ftell(f))});
+        fputc('K', f);
+        put_varint(f, frames);
+        put_varint(f, cycles);
+        put_varint(f, events);
+        put_varint(f, buffer.size());
+        fwrite(buffer.data(), 1, buffer.size(), f);
+    }
+
+    bool close(uint64_t total_cycles, uint64_t total_frames, uint64_t final_hash) {
+        fputc('X', f);
+        put_varint(f, total_cycles);
+        put_varint(f, total_frames);
+        fwrite(&final_hash, sizeof(final_hash), 1, f);
+        uint64_t index_offset = ftell(f);
+        put_varint(f, index.size());
+        for (const Keyframe& k : index) {
+            put_varint(f, k.frames);
+            put_varint(f, k.cycles);
+            put_varint(f, k.events);
+            put_varint(f, k.offset);
+        }
+        fwrite(&index_offset, sizeof(index_offset), 1, f);
+        bool ok = !ferror(f);
+        ok = (fclose(f) == 0) && ok;
+        f = nullptr;
+        return ok;
+    }
+
+private:
+    FILE* f = nullptr;
+    uint64_t keyframe_interval = 0;
+    uint64_t last_cycle = 0;
+    uint64_t events = 0;
+    std::vector<uint8_t> buffer;
+    std::vector<Keyframe> index;
+};
+
+// an input log opened for replay. Events are loaded up front; keyframe
+// snapshots are read from the file on demand through the index.
+class InputLogReader {
+public:
+    uint64_t start_cycle = 0;
+    uint64_t interval = 0;
+    uint64_t total_cycles = 0;
+    uint64_t total_frames = 0;
+    uint64_t final_hash = 0;
+    std::vector<InputEvent> events;
+    std::vector<Keyframe> keyframes;
+
+    ~InputLogReader() {
+        if (f) {
+            fclose(f);
+        }
+    }
+
+    bool open(const string& path) {
+        f = fopen(path.c_str(), "rb");
+        if (!f) {
+            return false;
+        }
+        char magic[sizeof(INPUT_LOG_MAGIC)];
+        if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) ||
+            memcmp(magic, INPUT_LOG_MAGIC, sizeof(magic)) != 0 ||
+            !get_varint(f, start_cycle) || !get_varint(f, interval)) {
+            return false;
+        }
+        long chunks = ftell(f);
+
+        // keyframe index via the footer. Each entry takes at least four bytes,
+        // which bounds the count before anything is allocated for it.
+        uint64_t index_offset = 0;
+        uint64_t count = 0;
+        if (fseek(f, -long(sizeof(index_offset)), SEEK_END) != 0) {
+            return false;
+        }
+        uint64_t footer = uint64_t(ftell(f));
+        if (fread(&index_offset, sizeof(index_offset), 1, f) != 1 || index_offset >= footer ||
+            fseek(f, long(index_offset), SEEK_SET) != 0 || !get_varint(f, count) ||
+            count > (footer - index_offset) / 4) {
+            return false;
+        }
+        keyframes.resize(count);
+        for (Keyframe& k : keyframes) {
+            if (!get_varint(f, k.frames) || !get_varint(f, k.cycles) ||
+                !get_varint(f, k.events) || !get_varint(f, k.offset)) {
+                return false;
+            }
+        }
+
+        // event chunks, skipping over keyframe payloads
+        fseek(f, chunks, SEEK_SET);
+        uint64_t cycle = 0;
+        for (;;) {
+            int tag = fgetc(f);
+            uint64_t a, b, c, size;
+            if (tag == 'E') {
+                int packed;
+                if (!get_varint(f, a) || (packed = fgetc(f)) == EOF) {
+                    return false;
+                }
+                // only button ports and harness actions, anything else is
+                // a corrupt or foreign log
+                if ((packed >> 1) > ACT_QUICKLOAD) {
+                    return false;
+                }
+                cycle += a;
+                events.push_back(InputEvent{cycle, uint8_t(packed >> 1), uint8_t(packed & 1)});
+            } else if (tag == 'K') {
+                if (!get_varint(f, a) || !get_varint(f, b) || !get_varint(f, c) ||
+                    !get_varint(f, size) || fseek(f, long(size), SEEK_CUR) != 0) {
+                    return false;
+                }
+            } else if (tag == 'X') {
+                return get_varint(f, total_cycles) && get_varint(f, total_frames) &&
+                       fread(&final_hash, sizeof(final_hash), 1, f) == 1;
+            } else {
+                return false;
+            }
+        }
+    }
+
+    // latest keyframe taken at or before `frame`, -1 if none
+    int keyframe_for(uint64_t frame) const {
+        int found = -1;
+        for (size_t i = 0; i < keyframes.size() && keyframes[i].frames <= frame; i++) {
+            found = int(i);
+        }
+        return found;
+    }
+
+    bool load_keyframe(int i, Snapshot& snap, Snapshot& quicksave) {
+        uint64_t a, b, c, size;
+        if (fseek(f, long(keyframes[i].offset), SEEK_SET) != 0 || fgetc(f) != 'K' ||
+            !get_varint(f, a) || !get_varint(f, b) || !get_varint(f, c) || !get_varint(f, size)) {
+            return false;
+        }
+        buffer.resize(size);
+        if (fread(buffer.data(), 1, size, f) != size) {
+            return false;
+        }
+        ByteReader r{buffer.data(), buffer.data() + buffer.size()};
+        if (!decode_snapshot(snap, r)) {
+            return false;
+        }
+        if (r.p == r.end) {
+            quicksave = Snapshot();
+            return true;
+        }
+        return decode_snapshot(quicksave, r);
+    }
+
+private:
+    FILE* f = nullptr;
+    std::vector<uint8_t> buffer;
+};
+
+// 'a' restarts the game. With a savable model this restores the snapshot taken
+// right after power-on reset instead of re-running reset(), which also avoids
+// depending on the game-state dependent reset path inside the RTL.
+void restart(const Snapshot& power_on) {
+    if (!power_on.valid()) {
+        reset();
+        return;
+    }
+    restore_snapshot(power_on);
+}
+
+// state captured right after the power-on reset, and the quick save slot
+thread_local Snapshot power_on_state;
+thread_local Snapshot quicksave_state;
+
+// --record-input log; button changes and actions actually applied to the
+// model are streamed into it in order
+InputLogWriter input_writer;
+
+// apply one button change or action to the model and log it. Button ports
+// are only written when the level actually changes.
+void apply_event(InputEvent event) {
+    switch (event.button) {
+        case ACT_RESTART:
+            restart(power_on_state);
+            break;
+        case ACT_QUICKSAVE:
+            if (!snapshots_supported()) {
+                return;
+            }
+            save_snapshot(quicksave_state);
+            break;
+        case ACT_QUICKLOAD:
+            if (!quicksave_state.valid()) {
+                return;
+            }
+            restore_snapshot(quicksave_state);
+            break;
+        default:
+            if (port_levels[event.button] == event.level) {
+                return;
+            }
+            set_port(event.button, event.level);
+            break;
+    }
+    event.cycle = cycles_simulated;
+    if (input_writer.is_open()) {
+        input_writer.event(event);
+    }
+}
+
+// set Verilog module inputs from the queued key events
+void apply_input() {
+    InputEvent event;
+    while (input_queue.pop(event)) {
+        apply_event(event);
+        // keys pressed before the restart belong to the previous run
+        if (event.button == ACT_RESTART) {
+            discard_input();
+        }
+    }
+}
+
+// set while seeking through a replay: frames are neither paced nor recorded
+thread_local bool fast_forward = false;
+
+// the back buffer holds a width x height frame: show it and count it
+void show_frame(int width, int height) {
+    publish_frame(width, height);
+    frame_count++;
+    frames_simulated++;
+    if (!fast_forward) {
+        pacer.frame_done(sim_cycles());
+    }
+}
+
+// the back buffer holds a complete width x height frame: record, hash and show it
+void complete_frame(int width, int height) {
+    width = min(width, MAX_WIDTH);
+    height = min(height, MAX_HEIGHT);
+    if (recorder.active() && !fast_forward) {
+        recorder.submit(back_buffer(), width, height);
+    }
+    if (hash_frames) {
+        last_frame_hash = hash_frame(back_buffer(), width, height);
+    }
+    show_frame(width, height);
+}
+
+// a pixel reported by the model itself, (x, y) in the active area
+void store_pixel(int x, int y, uint16_t rgb) {
+    if (unsigned(x) < unsigned(MAX_WIDTH) && unsigned(y) < unsigned(MAX_HEIGHT)) {
+        back_buffer()[y * MAX_WIDTH + x] = decode_pixel(rgb);
+    }
+}
+
+// video mode classes the scanout can lock to, largest first: the active
+// size and the standard back porches (after the end of the sync pulse, in
+// pixel clocks and lines), which place the active window where the picture
+// alone does not show its edges
+struct ModeClass {
+    int width;
+    int height;
+    int h_back;
+    int v_back;
+};
+const ModeClass MODE_CLASSES[] = {
+    {1280, 720, 220, 20},   // 1280x720@60 (CEA-861)
+    {800, 600, 88, 23},     // 800x600@60 (VESA)
+    {640, 480, 48, 33},     // 640x480@60
+};
+
+// start of a `size` long active window in a line (or frame) of `total` that
+// begins with a `sync` long pulse: `back` after the pulse, moved as little as
+// needed to cover the lit positions lo..hi (none if hi < lo)
+int place_window(int total, int sync, int size, int back, int lo, int hi) {
+    int first = sync;
+    int last = total - size;
+    int start = min(max(sync + back, first), last);
+    if (lo <= hi && max(first, hi - size + 1) <= min(last, lo)) {
+        start = min(max(start, hi - size + 1), lo);
+    }
+    return start;
+}
+
+// the sync signals no longer fit the timing, detect it again. The last pulse
+// and gap lengths carry over, so SCAN_SEEK goes on showing frames.
+void scan_lost() {
+    ScanState seek;
+    memcpy(seek.h_runs, scan.h_runs, sizeof(seek.h_runs));
+    memcpy(seek.v_runs, scan.v_runs, sizeof(seek.v_runs));
+    scan = seek;
+}
+
+// a frame while the timing is unknown: black, shown but not recorded
+void show_blank_frame() {
+    std::fill(back_buffer(), back_buffer() + FRAME_PIXELS, pack_rgba(0, 0, 0));
+    show_frame(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+}
+
+// SCAN_SEEK: time the pulses and gaps of h_sync and v_sync. The shorter level
+// of each is its pulse. Measuring starts with the next v_sync pulse; each
+// v_sync pulse is a (blank) frame, also while the timing never settles.
+bool scan_seek(bool h_sync, bool v_sync) {
+    if (h_sync != bool(scan.pre_h_sync)) {
+        if (scan.h_run) {
+            scan.h_runs[scan.pre_h_sync] = scan.h_run;
+        }
+        scan.h_run = 1;
+    } else if (scan.h_run) {
+        scan.h_run++;
+    }
+    bool v_edge = v_sync != bool(scan.pre_v_sync);
+    if (v_edge) {
+        if (scan.v_run) {
+            scan.v_runs[scan.pre_v_sync] = scan.v_run;
+        }
+        scan.v_run = 1;
+    } else if (scan.v_run) {
+        scan.v_run++;
+    }
+    if (!scan.v_runs[0] || !scan.v_runs[1] || !v_edge || int(v_sync) != (scan.v_runs[1] < scan.v_runs[0])) {
+        return false;
+    }
+    show_blank_frame();
+    if (!scan.h_runs[0] || !scan.h_runs[1] || !scan.h_run) {
+        return true;
+    }
+    scan.h_pulse = scan.h_runs[1] < scan.h_runs[0];
+    scan.v_pulse = v_sync;
+    scan.h_sync = scan.h_runs[scan.h_pulse];
+    scan.h_total = scan.h_runs[0] + scan.h_runs[1];
+    scan.v_sync = scan.v_runs[scan.v_pulse];
+    scan.x = (int(h_sync) == scan.h_pulse) ? scan.h_run - 1 : scan.h_sync + scan.h_run - 1;
+    scan.line = 0;
+    scan.phase = SCAN_MEASURE;
+    return true;
+}
+
+// SCAN_MEASURE is done: lock to the largest mode class that fits the blanking
+// and place its active window. The current pixel is the first of a frame.
+bool scan_lock() {
+    int v_sync_lines = max(1, (scan.v_sync + scan.h_total / 2) / scan.h_total);
+    for (const ModeClass& mode : MODE_CLASSES) {
+        if (mode.width > scan.h_total - scan.h_sync || mode.height > scan.v_total - v_sync_lines) {
+            continue;
+        }
+        scan.v_sync = v_sync_lines;
+        scan.width = mode.width;
+        scan.height = mode.height;
+        scan.h_start = place_window(scan.h_total, scan.h_sync, mode.width, mode.h_back, scan.lit_x0, scan.lit_x1);
+        scan.v_start = place_window(scan.v_total, scan.v_sync, mode.height, mode.v_back, scan.lit_y0, scan.lit_y1);
+        scan.segment_length[SEG_SYNC] = scan.h_sync;
+        scan.segment_length[SEG_BACK_PORCH] = scan.h_start - scan.h_sync;
+        scan.segment_length[SEG_ACTIVE] = scan.width;
+        scan.segment_length[SEG_FRONT_PORCH] = scan.h_total - scan.h_start - scan.width;
+        // line 0 is never active (v_start >= v_sync), so no pixel is stored in it
+        int end = 0;
+        for (scan.segment = SEG_SYNC; scan.x >= end + scan.segment_length[scan.segment]; scan.segment++) {
+            end += scan.segment_length[scan.segment];
+        }
+        scan.left = end + scan.segment_length[scan.segment] - scan.x - 1;
+        scan.pixel = -1;
+        scan.phase = SCAN_LOCKED;
+        return true;
+    }
+    return false;
+}
+
+// SCAN_MEASURE: count pixel clocks per line and lines per frame, and record
+// the extent of the lit pixels. Lines that are lit during h_sync (a design
+// drawing through the blanking) say nothing about the active window. Until
+// the mode is locked, frames are shown black and not recorded.
+bool scan_measure(bool h_pulse_start, bool v_pulse_start, uint16_t rgb) {
+    bool frame_done = false;
+    scan.x++;
+    if (h_pulse_start) {
+        if (scan.x != scan.h_total) {
+            scan_lost();
+            return false;
+        }
+        if (scan.line_lo <= scan.line_hi && !scan.line_lit_in_sync) {
+            bool first = scan.lit_x1 < scan.lit_x0;
+            scan.lit_x0 = first ? scan.line_lo : min(scan.lit_x0, scan.line_lo);
+            scan.lit_x1 = first ? scan.line_hi : max(scan.lit_x1, scan.line_hi);
+            scan.lit_y0 = first ? scan.line : min(scan.lit_y0, scan.line);
+            scan.lit_y1 = first ? scan.line : max(scan.lit_y1, scan.line);
+        }
+        scan.line_lo = 0;
+        scan.line_hi = -1;
+        scan.line_lit_in_sync = 0;
+        scan.x = 0;
+        scan.line++;
+    }
+    if (v_pulse_start) {
+        if (scan.frames == 0) {
+            scan.v_total = scan.line;
+        } else if (scan.line != scan.v_total) {
+            scan_lost();
+            show_blank_frame();
+            return true;
+        }
+        scan.frames++;
+        scan.line = 0;
+        show_blank_frame();
+        frame_done = true;
+        if (scan.frames == DETECT_FRAMES && !scan_lock()) {
+            scan_lost();
+        }
+        return frame_done;
+    }
+    if (decode_pixel(rgb) & 0xFFFFFF) {
+        if (scan.line_hi < scan.line_lo) {
+            scan.line_lo = scan.x;
+        }
+        scan.line_hi = scan.x;
+        scan.line_lit_in_sync |= scan.x < scan.h_sync;
+    }
+    return frame_done;
+}
+
+// SCAN_LOCKED: move to the next non-empty segment of the line. Returns true
+// if that completed the last active line of the frame.
+bool scan_next_segment() {
+    bool frame_done = false;
+    do {
+        if (scan.pixel >= 0 && scan.line == scan.v_start + scan.height - 1) {
+            complete_frame(scan.width, scan.height);
+            frame_done = true;
+        }
+        scan.pixel = -1;
+        scan.segment = (scan.segment + 1) % SEG_COUNT;
+        if (scan.segment == SEG_SYNC) {
+            scan.line++;
+        }
+        scan.left = scan.segment_length[scan.segment];
+        if (scan.segment == SEG_ACTIVE && unsigned(scan.line - scan.v_start) < unsigned(scan.height)) {
+            scan.pixel = (scan.line - scan.v_start) * MAX_WIDTH;
+        }
+    } while (scan.left == 0);
+    return frame_done;
+}
+
+// read VGA outputs and update graphics buffer, see ScanState
+bool sample_pixel(bool h_sync, bool v_sync, uint16_t rgb) {
+    bool frame_done = false;
+    bool v_pulse_start = v_sync != bool(scan.pre_v_sync) && int(v_sync) == scan.v_pulse;
+    switch (scan.phase) {
+        case SCAN_LOCKED:
+            if (scan.left == 0) {
+                frame_done = scan_next_segment();
+            }
+            scan.left--;
+            // h_sync must be at its pulse level exactly in the sync segment,
+            // and a v_sync pulse must start v_total lines after the last one
+            if ((int(h_sync) == scan.h_pulse) != (scan.segment == SEG_SYNC) ||
+                (v_pulse_start && scan.line != scan.v_total)) {
+                scan_lost();
+                break;
+            }
+            if (v_pulse_start) {
+                scan.line = 0;
+            }
+            if (scan.pixel >= 0) {
+                back_buffer()[scan.pixel++] = decode_pixel(rgb);
+            }
+            break;
+        case SCAN_MEASURE:
+            frame_done = scan_measure(h_sync != bool(scan.pre_h_sync) && int(h_sync) == scan.h_pulse,
+                                      v_pulse_start, rgb);
+            break;
+        default:
+            frame_done = scan_seek(h_sync, v_sync);
+            break;
+    }
+    scan.pre_h_sync = h_sync;
+    scan.pre_v_sync = v_sync;
+    return frame_done;
+}
+
+// returns the text after `name` if `arg` is of the form name<value>
+const char* option_value(const char* arg, const char* name) {
+    size_t len = strlen(name);
+    return strncmp(arg, name, len) == 0 ? arg + len : nullptr;
+}
+
+// print simulation throughput for a run that took `seconds` of wall time
+void report_throughput(ostream& os, uint64_t cycles, uint64_t frames, double seconds) {
+    os << "simulated cycles : " << cycles << endl;
+    os << "frames           : " << frames << endl;
+    os << "wall time        : " << seconds << " s" << endl;
+    if (seconds > 0) {
+        os << "cycles/s         : " << cycles / seconds << endl;
+        os << "frames/s         : " << frames / seconds << endl;
+        os << "real-time ratio  : " << cycles / BOARD_CLOCK_HZ / seconds << endl;
+    }
+}
+
+// advance the model by n board cycles, capturing a pixel on every pixel
+// clock. Only clock toggles, eval() and sampling happen in here (see
+// BoardModel::run()): callers apply input and update the LEDs around the batch.
+void run_cycles(uint64_t n) {
+    cycles_simulated += board->run(n, false);
+}
+
+// like run_cycles(), but stops right after the next frame has been
+// published. Returns false if max_cycles ran out first.
+bool run_until_vsync(uint64_t max_cycles) {
+    uint64_t frame = frames_simulated;
+    cycles_simulated += board->run(max_cycles, true);
+    return frames_simulated != frame;
+}
+
+// apply the replay events that are due and shorten batch so that it ends
+// on the next one
+uint64_t replay_events(const InputLogReader& replay, size_t& next, uint64_t batch) {
+    while (next < replay.events.size() && replay.events[next].cycle <= cycles_simulated) {
+        apply_event(replay.events[next++]);
+    }
+    if (next < replay.events.size()) {
+        batch = min(batch, replay.events[next].cycle - cycles_simulated);
+    }
+    return min(batch, replay.total_cycles - cycles_simulated);
+}
+
+// move a replay to the start of `frame`: restore the closest keyframe at or
+// before it, or keep going from here if that is closer, then re-simulate
+// the remaining frames without pacing. Backward seeks need keyframes.
+bool seek_replay(InputLogReader& replay, size_t& next, uint64_t frame) {
+    frame = min(frame, replay.total_frames);
+    int k = replay.keyframe_for(frame);
+    bool from_keyframe = k >= 0 &&
+        (frame < frames_simulated || replay.keyframes[k].frames > frames_simulated);
+    if (from_keyframe) {
+        Snapshot state;
+        if (!replay.load_keyframe(k, state, quicksave_state)) {
+            return false;
+        }
+        restore_snapshot(state);
+        cycles_simulated = replay.keyframes[k].cycles;
+        frames_simulated = replay.keyframes[k].frames;
+        next = replay.keyframes[k].events;
+    } else if (frame < frames_simulated) {
+        return false;
+    }
+
+    fast_forward = true;
+    while (frames_simulated < frame && cycles_simulated < replay.total_cycles) {
+        run_until_vsync(replay_events(replay, next, INPUT_BATCH_CYCLES));
+    }
+    fast_forward = false;
+    update_leds();
+    pacer.restart(sim_cycles());
+    return true;
+}
+
+// put this thread's board at the start of a replay: restore the state the
+// recording started from, or check that the session starts there
+bool begin_replay(InputLogReader& replay, string& error) {
+    if (!replay.keyframes.empty()) {
+        Snapshot start_state;
+        if (!replay.load_keyframe(0, start_state, quicksave_state)) {
+            error = "cannot read keyframe";
+            return false;
+        }
+        restore_snapshot(start_state);
+    }
+    if (sim_cycles() != replay.start_cycle) {
+        error = "recorded from cycle " + to_string(replay.start_cycle) +
+                ", this session starts at cycle " + to_string(sim_cycles()) +
+                " (use the same --load-state as the recording)";
+        return false;
+    }
+    return true;
+}
+
+// one --regress scenario: a --record-input log, replayed and checked to end
+// on the recorded frame
+struct ScenarioResult {
+    string path;
+    bool pass = false;
+    string error;
+    uint64_t cycles = 0;
+    uint64_t frames = 0;
+    double seconds = 0;
+};
+
+// replay a scenario on a board of this thread's own, headless and unthrottled
+void run_scenario(ScenarioResult& result) {
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    std::unique_ptr<BoardOutputs> own_outputs(new BoardOutputs);
+    outputs = own_outputs.get();
+    std::unique_ptr<BoardModel> own_board(board_info.create(0, nullptr));
+    board = own_board.get();
+    board->cycles_per_pixel = pixel_clock_ratio;
+    pacer.mode = Pacer::UNTHROTTLED;
+    hash_frames = true;
+    // counters left over from the previous scenario on this thread
+    cycles_simulated = 0;
+    frame_count = 0;
+    frames_simulated = 0;
+    last_frame_hash = 0;
+    quicksave_state = Snapshot();
+
+    reset();
+    if (snapshots_supported()) {
+        save_snapshot(power_on_state);
+    }
+    InputLogReader replay;
+    size_t next = 0;
+    if (!replay.open(result.path)) {
+        result.error = "cannot read input log";
+    } else if (begin_replay(replay, result.error)) {
+        while (!board->got_finish() && cycles_simulated < replay.total_cycles) {
+            run_cycles(replay_events(replay, next, INPUT_BATCH_CYCLES));
+        }
+        result.pass = cycles_simulated == replay.total_cycles &&
+                      frames_simulated == replay.total_frames &&
+                      last_frame_hash == replay.final_hash;
+        if (!result.pass) {
+            result.error = "differs from recording";
+        }
+    }
+    result.cycles = cycles_simulated;
+    result.frames = frames_simulated;
+
+    board->final();
+    board = nullptr;
+    outputs = &window_outputs;
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+}
+
+// worker thread: take scenarios off the list until none are left
+void regression_worker(std::vector<ScenarioResult>* results, std::atomic<size_t>* next) {
+    size_t i;
+    while ((i = (*next)++) < results->size()) {
+        run_scenario((*results)[i]);
+    }
+}
+
+// run every input log named in `list_path` (one per line, # comments) on
+// `jobs` worker threads, print a line per scenario and the totals.
+// Returns the process exit code: 0 if all passed, 2 otherwise.
+int run_regression(const string& list_path, unsigned jobs, ostream& report) {
+    std::vector<ScenarioResult> results;
+    FILE* f = fopen(list_path.c_str(), "r");
+    if (!f) {
+        cerr << "Error: cannot read scenario list " << list_path << endl;
+        return 1;
+    }
+    char line[4096];
+    while (fgets(line, sizeof(line), f)) {
+        string path = line;
+        path.erase(0, path.find_first_not_of(" \t"));
+        path.erase(path.find_last_not_of(" \t\r\n") + 1);
+        if (!path.empty() && path[0] != '#') {
+            results.emplace_back();
+            results.back().path = path;
+        }
+    }
+    fclose(f);
+
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    std::atomic<size_t> next(0);
+    std::vector<thread> workers;
+    for (unsigned i = 0; i < max(jobs, 1u) && i < results.size(); i++) {
+        workers.emplace_back(regression_worker, &results, &next);
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start_time;
+
+    size_t passed = 0;
+    uint64_t cycles = 0;
+    uint64_t frames = 0;
+    for (const ScenarioResult& r : results) {
+        report << (r.pass ? "PASS " : "FAIL ") << r.path << "  " << r.frames << " frames, "
+               << (r.seconds > 0 ? r.cycles / r.seconds : 0) << " cycles/s";
+        if (!r.pass) {
+            report << "  (" << r.error << ")";
+        }
+        report << endl;
+        passed += r.pass;
+        cycles += r.cycles;
+        frames += r.frames;
+    }
+    report << "passed           : " << passed << " / " << results.size() << endl;
+    report << "jobs             : " << workers.size() << endl;
+    report_throughput(report, cycles, frames, elapsed.count());
+    return passed == results.size() ? 0 : 2;
+}
+
+// CPU placement of a multi-threaded model (Linux). Verilator starts its
+// worker threads when the model is constructed. The sim thread, which runs
+// eval() as model thread 0, and every worker then get a CPU of their own,
+// one logical CPU per physical core so that no two of them are SMT siblings.
+// All other threads (GLUT, frame recorder) keep the CPUs left over.
+// --no-pin leaves the placement to the OS.
+bool pin_threads = true;
+
+// ids of the threads of this process
+std::vector<pid_t> thread_ids() {
+    std::vector<pid_t> ids;
+    DIR* dir = opendir("/proc/self/task");
+    if (!dir) {
+        return ids;
+    }
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            ids.push_back(pid_t(atoi(entry->d_name)));
+        }
+    }
+    closedir(dir);
+    return ids;
+}
+
+// an integer from a sysfs file, -1 if unavailable
+int read_sysfs_int(const string& path) {
+    FILE* f = fopen(path.c_str(), "r");
+    int value = -1;
+    if (f) {
+        if (fscanf(f, "%d", &value) != 1) {
+            value = -1;
+        }
+        fclose(f);
+    }
+    return value;
+}
+
+// CPUs of `allowed` to place model threads on: first one logical CPU per
+// physical core, then the SMT siblings, in CPU order
+std::vector<int> placement_cpus(const cpu_set_t& allowed) {
+    std::vector<int> first, siblings;
+    std::set<std::pair<int, int>> cores;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        string topology = "/sys/devices/system/cpu/cpu" + to_string(cpu) + "/topology/";
+        int core = read_sysfs_int(topology + "core_id");
+        int package = read_sysfs_int(topology + "physical_package_id");
+        // without topology information every CPU counts as a core
+        if (core < 0 || cores.insert({package, core}).second) {
+            first.push_back(cpu);
+        } else {
+            siblings.push_back(cpu);
+        }
+    }
+    first.insert(first.end(), siblings.begin(), siblings.end());
+    return first;
+}
+
+// pin the model threads of a board created after `before` was taken: the
+// calling sim thread and the workers that have appeared since
+void pin_model_threads(const std::vector<pid_t>& before) {
+    std::vector<pid_t> model(1, pid_t(syscall(SYS_gettid)));
+    std::vector<pid_t> others;
+    for (pid_t id : thread_ids()) {
+        if (id == model[0]) {
+            continue;
+        }
+        if (std::find(before.begin(), before.end(), id) == before.end()) {
+            model.push_back(id);
+        } else {
+            others.push_back(id);
+        }
+    }
+    if (!pin_threads || model.size() < 2) {
+        return;
+    }
+
+    // the CPUs the process was started on; after the first call the sim
+    // thread itself is pinned, so remember them
+    static cpu_set_t allowed;
+    static bool have_allowed = false;
+    if (!have_allowed) {
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+            return;
+        }
+        have_allowed = true;
+    }
+    std::vector<int> cpus = placement_cpus(allowed);
+    if (cpus.size() < model.size()) {
+        cerr << "Warning: " << model.size() << " model threads but only " << cpus.size()
+             << " CPUs, threads are not pinned" << endl;
+        return;
+    }
+
+    cpu_set_t rest = allowed;
+    string placed;
+    for (size_t i = 0; i < model.size(); i++) {
+        cpu_set_t one;
+        CPU_ZERO(&one);
+        CPU_SET(cpus[i], &one);
+        CPU_CLR(cpus[i], &rest);
+        sched_setaffinity(model[i], sizeof(one), &one);
+        placed += (i ? "," : "") + to_string(cpus[i]);
+    }
+    // threads that exited meanwhile (workers of a replaced model) just fail
+    if (CPU_COUNT(&rest) > 0) {
+        for (pid_t id : others) {
+            sched_setaffinity(id, sizeof(rest), &rest);
+        }
+    }
+    cout << "model threads pinned to CPUs " << placed << endl;
+}
+
+// 'm': rebuild the model and swap it in, keeping the window and the command
+// line settings. The new model starts from power-on reset; states of the old
+// one (quick save slot, rewind history) do not apply to it and are dropped.
+void reload_board(std::unique_ptr<BoardModel>& main_board, int argc, char** argv) {
+    if (!board_info.reload) {
+        cerr << "reload: this simulator is linked with its model, build it with PLUGIN=1 to reload" << endl;
+        return;
+    }
+    BoardInfo info = board_info;
+    string error;
+    if (!info.reload(info, error)) {
+        cerr << "reload failed, keeping the current model: " << error << endl;
+        return;
+    }
+    board->final();
+    std::vector<pid_t> threads_before = thread_ids();
+    main_board.reset(info.create(argc, argv));
+    pin_model_threads(threads_before);
+    board = main_board.get();
+    board->cycles_per_pixel = pixel_clock_ratio;
+    board_info = info;
+    decode_pixel.init(info.decode);
+    reset();
+    discard_input();
+
+    power_on_state = Snapshot();
+    quicksave_state = Snapshot();
+    if (snapshots_supported()) {
+        save_snapshot(power_on_state);
+        rewind_history.clear();
+    } else {
+        rewind_history.reset(0);
+    }
+    cout << "model reloaded" << endl;
+}
+
+int simulator_main(int argc, char** argv, const BoardInfo& info) {
+    // --present=rects        immediate-mode fallback for the VGA area
+    // --speed=<ratio>        run at <ratio> x real time of the 50 MHz clock (default 1)
+    // --fps=<n>              run at <n> VGA frames per second
+    // --unthrottled          run as fast as possible
+    // --headless             no window; unthrottled unless --speed/--fps is given,
+    //                        prints throughput at exit
+    // --cycles=<n>           stop after <n> board clock cycles
+    // --frames=<n>           stop after <n> VGA frames
+    // --record=<file>        stream every frame to <file> ("-" for stdout),
+    //                        Y4M if the name ends in .y4m, raw RGB24 otherwise
+    // --record-format=<fmt>  force "y4m" or "rgb"
+    // --load-state=<file>    start from a snapshot written by --save-state
+    // --save-state=<file>    write a snapshot of the final state on exit
+    // --record-input=<file>  log every button change and action with its cycle
+    // --replay=<file>        feed a --record-input log back instead of the
+    //                        keyboard and check the run ends on the same frame
+    // --keyframe-interval=<n> snapshot every <n> frames into the input log so
+    //                        replays can seek (default 600, 0 for none)
+    // --seek=<frame>         start a replay at <frame>; digits then 'j' in the
+    //                        window seek while it runs
+    // --rewind=<seconds>     frames kept for rewinding with a held 'r' (default
+    //                        10 s, 0 for none; off headless and with input logs)
+    // --pixel-clock-ratio=<n> sample the VGA outputs every <n> board clocks
+    //                        (default 2), unless the board names its pixel clock
+    // --regress=<list>       replay every input log listed in <list>, one board
+    //                        per worker thread, and report pass/fail
+    // --jobs=<n>             worker threads for --regress (default: all cores)
+    // --no-pin               leave the CPU placement of a multi-threaded model's
+    //                        threads to the OS (see pin_model_threads())
+    board_info = info;
+    decode_pixel.init(info.decode);
+
+    bool headless = false;
+    bool paced = false;
+    uint64_t max_cycles = 0;
+    uint64_t max_frames = 0;
+    string record_path;
+    string record_format;
+    string load_state_path;
+    string save_state_path;
+    string record_input_path;
+    string replay_path;
+    uint64_t keyframe_interval = 600;
+    int64_t seek_frame = -1;
+    double rewind_seconds = 10;
+    string regress_path;
+    unsigned jobs = thread::hardware_concurrency();
+    for (int i = 1; i < argc; i++) {
+        const char* value;
+        if (string(argv[i]) == "--present=rects") {
+            present_mode = PRESENT_RECTS;
+        } else if (string(argv[i]) == "--present=texture") {
+            present_mode = PRESENT_TEXTURE;
+        } else if ((value = option_value(argv[i], "--speed="))) {
+            pacer.mode = Pacer::REALTIME;
+            pacer.speed = atof(value);
+            paced = true;
+        } else if ((value = option_value(argv[i], "--fps="))) {
+            pacer.mode = Pacer::FRAMERATE;
+            pacer.fps = atof(value);
+            paced = true;
+        } else if (string(argv[i]) == "--unthrottled") {
+            pacer.mode = Pacer::UNTHROTTLED;
+            paced = true;
+        } else if (string(argv[i]) == "--headless") {
+            headless = true;
+        } else if ((value = option_value(argv[i], "--cycles="))) {
+            max_cycles = strtoull(value, nullptr, 10);
+        } else if ((value = option_value(argv[i], "--frames="))) {
+            max_frames = strtoull(value, nullptr, 10);
+        } else if ((value = option_value(argv[i], "--record="))) {
+            record_path = value;
+        } else if ((value = option_value(argv[i], "--record-format="))) {
+            record_format = value;
+        } else if ((value = option_value(argv[i], "--load-state="))) {
+            load_state_path = value;
+        } else if ((value = option_value(argv[i], "--save-state="))) {
+            save_state_path = value;
+        } else if ((value = option_value(argv[i], "--record-input="))) {
+            record_input_path = value;
+        } else if ((value = option_value(argv[i], "--replay="))) {
+            replay_path = value;
+        } else if ((value = option_value(argv[i], "--keyframe-interval="))) {
+            keyframe_interval = strtoull(value, nullptr, 10);
+        } else if ((value = option_value(argv[i], "--seek="))) {
+            seek_frame = strtoll(value, nullptr, 10);
+        } else if ((value = option_value(argv[i], "--rewind="))) {
+            rewind_seconds = atof(value);
+        } else if ((value = option_value(argv[i], "--pixel-clock-ratio="))) {
+            pixel_clock_ratio = max(1, atoi(value));
+        } else if ((value = option_value(argv[i], "--regress="))) {
+            regress_path = value;
+        } else if ((value = option_value(argv[i], "--jobs="))) {
+            jobs = strtoul(value, nullptr, 10);
+        } else if (string(argv[i]) == "--no-pin") {
+            pin_threads = false;
+        }
+    }
+#ifdef SIM_NO_GL
+    headless = true;
+#endif
+    if (headless && !paced) {
+        pacer.mode = Pacer::UNTHROTTLED;
+    }
+    if (!regress_path.empty()) {
+        return run_regression(regress_path, jobs, cout);
+    }
+    if (!snapshots_supported() && (!load_state_path.empty() || !save_state_path.empty())) {
+        cerr << "Error: snapshots need a model Verilated with --savable and -DSIM_SAVABLE" << endl;
+        return 1;
+    }
+
+    // reports go to stderr when the recording is piped through stdout
+    ostream& report = (record_path == "-") ? cerr : cout;
+    if (!record_path.empty()) {
+        bool y4m = record_format.empty()
+            ? (record_path.size() > 4 && record_path.compare(record_path.size() - 4, 4, ".y4m") == 0)
+            : (record_format == "y4m");
+        if (!recorder.start(record_path, y4m ? FrameRecorder::Y4M : FrameRecorder::RAW_RGB, 60)) {
+            cerr << "Error: cannot open " << record_path << " for recording" << endl;
+            return 1;
+        }
+    }
+    InputLogReader replay;
+    if (!replay_path.empty()) {
+        if (!replay.open(replay_path)) {
+            cerr << "Error: cannot read input log " << replay_path << endl;
+            return 1;
+        }
+        // the replay ends where the recording did
+        max_cycles = replay.total_cycles;
+        max_frames = 0;
+    }
+    hash_frames = !record_input_path.empty() || !replay_path.empty();
+    if ((pacer.mode == Pacer::REALTIME && pacer.speed <= 0) ||
+        (pacer.mode == Pacer::FRAMERATE && pacer.fps <= 0)) {
+        pacer.mode = Pacer::UNTHROTTLED;
+    }
+
+    GraphicsThread gl_thread;
+#ifndef SIM_NO_GL
+    if (!headless) {
+        // create a new thread for graphics handling
+        gl_thread.start(argc, argv);
+        // wait for graphics initialization to complete
+        while(!gl_setup_complete);
+    }
+#endif
+
+    // create the model, and place its threads
+    std::vector<pid_t> threads_before = thread_ids();
+    std::unique_ptr<BoardModel> main_board(board_info.create(argc, argv));
+    pin_model_threads(threads_before);
+    board = main_board.get();
+    board->cycles_per_pixel = pixel_clock_ratio;
+
+    // reset the model, dropping keys pressed while the window came up
+    reset();
+    discard_input();
+
+    // power-on state for instant restarts
+    if (snapshots_supported()) {
+        save_snapshot(power_on_state);
+    }
+    if (!load_state_path.empty()) {
+        Snapshot loaded;
+        if (!read_snapshot(loaded, load_state_path)) {
+            cerr << "Error: cannot load snapshot " << load_state_path << endl;
+            return 1;
+        }
+        restore_snapshot(loaded);
+    }
+
+    size_t replay_next = 0;
+    string replay_error;
+    if (!replay_path.empty() && !begin_replay(replay, replay_error)) {
+        cerr << "Error: " << replay_path << ": " << replay_error << endl;
+        return 1;
+    }
+
+    uint64_t start_cycles = sim_cycles();
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    if (!record_input_path.empty()) {
+        if (!snapshots_supported()) {
+            keyframe_interval = 0;
+        }
+        if (!input_writer.open(record_input_path, start_cycles, keyframe_interval)) {
+            cerr << "Error: cannot write input log " << record_input_path << endl;
+            return 1;
+        }
+        // keyframe 0 keeps the back buffer, the session may start mid-frame
+        if (keyframe_interval) {
+            Snapshot start_state;
+            save_snapshot(start_state);
+            input_writer.keyframe(start_state, quicksave_state, 0, cycles_simulated);
+        }
+    }
+    if (seek_frame >= 0) {
+        seek_request = seek_frame;
+    }
+    Snapshot keyframe;
+    // rewinding would break the cycle stamps of an input log
+    if (snapshots_supported() && !headless && replay_path.empty() && record_input_path.empty() &&
+        rewind_seconds > 0) {
+        rewind_history.reset(rewind_capacity(rewind_seconds, 0));
+    }
+    bool at_vsync = false;
+    // cycles_simulated at the last frame boundary, to measure frame lengths
+    uint64_t last_vsync_cycles = 0;
+
+    // cycle accurate simulation loop
+    while (!board->got_finish() && !window_closed) {
+        if ((max_cycles && cycles_simulated >= max_cycles) ||
+            (max_frames && frames_simulated >= max_frames)) {
+            break;
+        }
+
+        if (reload_request.exchange(false)) {
+            // an input log only fits the model it was recorded with
+            if (!replay_path.empty() || input_writer.is_open()) {
+                cerr << "reload: not while replaying or recording an input log" << endl;
+            } else {
+                reload_board(main_board, argc, argv);
+            }
+        }
+
+        // inputs and LEDs are synchronised once per batch of cycles
+        uint64_t batch = INPUT_BATCH_CYCLES;
+        if (!replay_path.empty()) {
+            int64_t seek = seek_request.exchange(-1);
+            if (seek >= 0 && !seek_replay(replay, replay_next, uint64_t(seek))) {
+                cerr << "cannot seek back to frame " << seek << " without keyframes" << endl;
+            }
+            batch = replay_events(replay, replay_next, batch);
+        } else {
+            // rewinding steps between frame boundaries only
+            if (rewind_held && at_vsync) {
+                rewind_frame();
+            }
+            apply_input();
+        }
+        if (max_cycles) {
+            batch = min(batch, max_cycles - cycles_simulated);
+        }
+        // keyframes and rewind states are taken right after a frame has been published
+        at_vsync = false;
+        if (max_frames || input_writer.interval() || rewind_history.enabled()) {
+            at_vsync = run_until_vsync(batch);
+        } else {
+            run_cycles(batch);
+        }
+        update_leds();
+
+        if (at_vsync && input_writer.interval() &&
+            frames_simulated % input_writer.interval() == 0) {
+            save_snapshot(keyframe, false);
+            input_writer.keyframe(keyframe, quicksave_state, frames_simulated, cycles_simulated);
+        }
+        if (at_vsync && rewind_history.enabled()) {
+            // the frame length is known once a video mode has been locked
+            // (or a frame measured), and changes with the mode
+            uint64_t measured = last_vsync_cycles ? cycles_simulated - last_vsync_cycles : 0;
+            last_vsync_cycles = cycles_simulated;
+            rewind_history.set_capacity(rewind_capacity(rewind_seconds, measured));
+            push_rewind_state();
+        }
+    }
+
+    if (headless) {
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start_time;
+        report << "model threads    : " << board->threads() << endl;
+        if (scan.phase == SCAN_LOCKED) {
+            report << "video mode       : " << scan.width << "x" << scan.height << " ("
+                   << scan.h_total << "x" << scan.v_total << " total)" << endl;
+        }
+        report_throughput(report, cycles_simulated, frames_simulated, elapsed.count());
+    }
+    if (input_writer.is_open() &&
+        !input_writer.close(cycles_simulated, frames_simulated, last_frame_hash)) {
+        cerr << "Error: cannot write input log " << record_input_path << endl;
+    }
+    int exit_code = 0;
+    if (!replay_path.empty()) {
+        bool match = cycles_simulated == replay.total_cycles &&
+                     frames_simulated == replay.total_frames &&
+                     last_frame_hash == replay.final_hash;
+        report << "replay           : " << (match ? "matches recording" : "DIFFERS from recording") << endl;
+        exit_code = match ? 0 : 2;
+    }
+    if (!save_state_path.empty()) {
+        Snapshot final_state;
+        save_snapshot(final_state);
+        if (!write_snapshot(final_state, save_state_path)) {
+            cerr << "Error: cannot write snapshot " << save_state_path << endl;
+        }
+    }
+    if (recorder.active()) {
+        recorder.finish();
+        report << "recorded frames  : " << recorder.frames_written();
+        if (recorder.frame_width()) {
+            report << " of " << recorder.frame_width() << "x" << recorder.frame_height();
+        }
+        report << " (" << recorder.frames_dropped() << " dropped)" << endl;
+    }
+
+    board->final();
+    board = nullptr;
+
+    // the GLUT thread uses the frame buffers and textures until it has left
+    // glutMainLoop(), stop it before they are destroyed
+    gl_thread.stop();
+    return exit_code;
+}
+
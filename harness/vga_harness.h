@@ -0,0 +1,115 @@
+// Shared VGA/LED development board simulator harness.
+//
+// vga_harness.cpp is compiled once, together with the Verilator runtime, into
+// a library (see build_harness.sh). A board project only Verilates its model
+// and compiles a simulator.cpp that describes the board with a traits class,
+// see vga_board.h.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+inline uint32_t pack_rgba(uint8_t r, uint8_t g, uint8_t b) {
+    return uint32_t(r) | (uint32_t(g) << 8) | (uint32_t(b) << 16) | 0xFF000000u;
+}
+inline uint8_t rgba_r(uint32_t p) { return p & 0xFF; }
+inline uint8_t rgba_g(uint32_t p) { return (p >> 8) & 0xFF; }
+inline uint8_t rgba_b(uint32_t p) { return (p >> 16) & 0xFF; }
+
+// widen a 5/6-bit channel to 8 bits by bit replication, so full scale maps to 255
+inline uint8_t expand5(uint8_t v) { return (v << 3) | (v >> 2); }
+inline uint8_t expand6(uint8_t v) { return (v << 2) | (v >> 4); }
+
+// color encodings of the 16-bit rgb port, selected per board by the
+// PixelFormat of its traits class
+
+// {r5, g6, b5}: ColorBar / vga_ctrl (Lab3, Lab4, Available2)
+struct Rgb565 {
+    static uint32_t decode(uint16_t rgb) {
+        return pack_rgba(expand5((rgb >> 11) & 0x1F), expand6((rgb >> 5) & 0x3F), expand5(rgb & 0x1F));
+    }
+};
+
+// {1'b0, r5, g5, b5}: Breakout DevelopmentBoard
+struct Rgb555 {
+    static uint32_t decode(uint16_t rgb) {
+        return pack_rgba(expand5((rgb >> 10) & 0x1F), expand5((rgb >> 5) & 0x1F), expand5(rgb & 0x1F));
+    }
+};
+
+// 1-bit channels replicated into an RGB555 word, only the top bit of each
+// field is significant
+struct Rgb111 {
+    static uint32_t decode(uint16_t rgb) {
+        return pack_rgba((rgb & 0x4000) ? 0xFF : 0, (rgb & 0x0200) ? 0xFF : 0, (rgb & 0x0010) ? 0xFF : 0);
+    }
+};
+
+// board buttons, in the order of the model's input ports
+enum Button { BTN_RESET, BTN_B2, BTN_B3, BTN_B4, BTN_B5, BUTTON_COUNT };
+
+// the clock frequency of VGA is normally half of that of the whole model,
+// so by default we sample from VGA every other clock
+const int CYCLES_PER_PIXEL = 2;
+
+// scan one VGA pixel into the frame buffer, called once per pixel clock with
+// the model outputs. Returns true if it completed and published a frame.
+bool sample_pixel(bool h_sync, bool v_sync, uint16_t rgb);
+
+// instead of sample_pixel(), for models whose VGA timing module reports its
+// pixels (+define+VGA_PIXEL_SINK, see vga_board.h): store the pixel at (x, y)
+// of the active area, and publish the width x height frame once its last line
+// is done
+void store_pixel(int x, int y, uint16_t rgb);
+void complete_frame(int width, int height);
+
+// a simulated board as seen by the harness: VerilatedBoard<Traits> in
+// vga_board.h, or a model plugin loaded by vga_sim.cpp. Everything per cycle
+// happens in run(), which is compiled with the model so eval() can be inlined.
+class BoardModel {
+public:
+    uint64_t time = 0;          // simulation time, two steps per board clock
+    int pixel_phase = 0;        // board clocks since the last pixel clock
+    // board clocks per pixel clock (--pixel-clock-ratio), unless the model
+    // names its pixel clock signal and is sampled on its edges (vga_board.h)
+    int cycles_per_pixel = CYCLES_PER_PIXEL;
+
+    virtual ~BoardModel() {}
+
+    // drive one button port
+    virtual void set_port(int button, uint8_t level) = 0;
+    // LED outputs, bit i is the level of led(i+1), 0 = lit
+    virtual int leds() = 0;
+    // drive clk low and settle the model
+    virtual void clock_low() = 0;
+    // one board clock period without sampling the VGA outputs
+    virtual void step_clock() = 0;
+    // run up to n board clocks, sampling a pixel on every pixel clock (or
+    // storing the pixels the model reports). With stop_at_frame, returns
+    // right after a frame has been published.
+    // Returns the number of clocks run.
+    virtual uint64_t run(uint64_t n, bool stop_at_frame) = 0;
+    // serialize the model (Verilator --savable), false if unsupported
+    virtual bool save(std::vector<uint8_t>& out) = 0;
+    virtual bool restore(const std::vector<uint8_t>& in) = 0;
+    virtual bool got_finish() = 0;
+    virtual unsigned threads() = 0;
+    virtual void final() = 0;
+};
+
+// what the harness needs to know about a board
+struct BoardInfo {
+    // a new board on its own Verilator context. argv is passed on as the
+    // model's command line (plusargs); argc may be 0.
+    BoardModel* (*create)(int argc, char** argv);
+    uint32_t (*decode)(uint16_t rgb);   // PixelFormat::decode
+    bool savable;                       // model Verilated with --savable
+    // rebuild the model and load the new one, or null if the board cannot
+    // be reloaded. On success updates info; boards created before keep
+    // working until they are destroyed.
+    bool (*reload)(BoardInfo& info, std::string& error);
+};
+
+// the simulator: parses the command line and runs the board
+int simulator_main(int argc, char** argv, const BoardInfo& info);
@@ -0,0 +1,85 @@
+/* C ABI of a board model built as a shared object (a "model plugin").
+ *
+ * With PLUGIN=1, run_simulation.sh compiles the project's simulator.cpp with
+ * -DSIM_PLUGIN and links it, the Verilated model and the Verilator runtime
+ * into VDevelopmentBoard.so. The generic viewer vga_sim (vga_sim.cpp) loads
+ * it with dlopen(), so one prebuilt viewer runs every project and can swap in
+ * a rebuilt model without closing its window.
+ *
+ * The plugin exports a single function, vga_model_entry(), returning its
+ * function table. Only plain C types cross the boundary, so the viewer and
+ * the plugin may be built with different compilers or flags.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* bumped whenever vga_model_api changes */
+#define VGA_MODEL_ABI_VERSION 4
+
+/* name of the entry point looked up with dlsym() */
+#define VGA_MODEL_ENTRY "vga_model_entry"
+
+/* one board instance on its own Verilator context */
+typedef struct vga_model vga_model;
+
+/* viewer callback, called once per pixel clock with the model outputs.
+ * Returns nonzero when the pixel completed a frame. */
+typedef int (*vga_sample_fn)(int h_sync, int v_sync, uint16_t rgb);
+
+/* viewer callbacks for models that report their own pixels (+define+VGA_PIXEL_SINK):
+ * the pixel at (x, y) of the active area, and the end of the last active line
+ * of a width x height frame */
+typedef void (*vga_pixel_fn)(int x, int y, uint16_t rgb);
+typedef void (*vga_frame_fn)(int width, int height);
+
+/* byte sink for vga_model_api.save */
+typedef void (*vga_write_fn)(void* ctx, const uint8_t* data, size_t size);
+
+typedef struct vga_model_api {
+    uint32_t abi_version;           /* VGA_MODEL_ABI_VERSION */
+    int savable;                    /* model Verilated with --savable */
+    uint32_t (*decode)(uint16_t rgb);   /* rgb port value to packed RGBA */
+
+    /* argv is passed on as the model's command line (plusargs), argc may be 0 */
+    vga_model* (*create)(int argc, char** argv, vga_sample_fn sample,
+                         vga_pixel_fn pixel, vga_frame_fn frame);
+    void (*destroy)(vga_model* model);
+
+    /* port accessors: button index as in vga_harness.h (active low levels),
+     * LED bit i is the level of led(i+1) */
+    void (*set_port)(vga_model* model, int button, uint8_t level);
+    int (*leds)(vga_model* model);
+
+    /* evaluation. The viewer owns the simulation time and pixel phase and
+     * passes them in and out of every call. run() evaluates up to `cycles`
+     * board clocks, calling `sample` on every pixel clock (every
+     * `cycles_per_pixel` board clocks if the model does not name its pixel
+     * clock), or `pixel` and
+     * `frame` if the model reports its pixels; with stop_at_frame it returns
+     * right after a frame has been completed. It returns the number of
+     * clocks run. */
+    void (*clock_low)(vga_model* model);
+    void (*step_clock)(vga_model* model, uint64_t* time);
+    uint64_t (*run)(vga_model* model, uint64_t* time, int* pixel_phase, int cycles_per_pixel,
+                    uint64_t cycles, int stop_at_frame);
+
+    /* Verilator --savable state, both return 0 if unsupported */
+    int (*save)(vga_model* model, vga_write_fn write, void* ctx);
+    int (*restore)(vga_model* model, const uint8_t* data, size_t size);
+
+    int (*got_finish)(vga_model* model);
+    unsigned (*threads)(vga_model* model);
+    void (*final)(vga_model* model);
+} vga_model_api;
+
+typedef const vga_model_api* (*vga_model_entry_fn)(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,157 @@
+// Generic viewer for board models built as plugins (PLUGIN=1 run_simulation.sh,
+// see vga_plugin.h). Built once by build_harness.sh, it runs any project:
+//
+//     vga_sim --model=<VDevelopmentBoard.so> [--rebuild=<command>] [simulator options...]
+//
+// 'm' in the window runs the --rebuild command through the shell and loads
+// the model again; the window and the command line settings carry over.
+#include <dlfcn.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "vga_harness.h"
+#include "vga_plugin.h"
+
+using namespace std;
+
+// the loaded model plugin, new boards are created from it
+const vga_model_api* model_api = nullptr;
+string model_path;
+string rebuild_command;
+
+int viewer_sample(int h_sync, int v_sync, uint16_t rgb) {
+    return sample_pixel(h_sync, v_sync, rgb);
+}
+void viewer_pixel(int x, int y, uint16_t rgb) {
+    store_pixel(x, y, rgb);
+}
+void viewer_frame(int width, int height) {
+    complete_frame(width, height);
+}
+
+// a board created by a model plugin. It keeps the function table it was
+// created with, so it stays usable after a reload has loaded another one.
+class PluginBoard final : public BoardModel {
+public:
+    PluginBoard(const vga_model_api* api, int argc, char** argv)
+        : api(api), model(api->create(argc, argv, viewer_sample, viewer_pixel, viewer_frame)) {}
+    ~PluginBoard() override { api->destroy(model); }
+
+    static BoardModel* create(int argc, char** argv) {
+        return new PluginBoard(model_api, argc, argv);
+    }
+
+    void set_port(int button, uint8_t level) override { api->set_port(model, button, level); }
+    int leds() override { return api->leds(model); }
+    void clock_low() override { api->clock_low(model); }
+    void step_clock() override { api->step_clock(model, &time); }
+
+    uint64_t run(uint64_t n, bool stop_at_frame) override {
+        return api->run(model, &time, &pixel_phase, cycles_per_pixel, n, stop_at_frame);
+    }
+
+    bool save(std::vector<uint8_t>& out) override {
+        out.clear();
+        return api->save(model, append, &out) != 0;
+    }
+    bool restore(const std::vector<uint8_t>& in) override {
+        return api->restore(model, in.data(), in.size()) != 0;
+    }
+
+    bool got_finish() override { return api->got_finish(model) != 0; }
+    unsigned threads() override { return api->threads(model); }
+    void final() override { api->final(model); }
+
+private:
+    static void append(void* ctx, const uint8_t* data, size_t size) {
+        std::vector<uint8_t>* out = static_cast<std::vector<uint8_t>*>(ctx);
+        out->insert(out->end(), data, data + size);
+    }
+
+    const vga_model_api* api;
+    vga_model* model;
+};
+
+// load the model plugin at `path` and describe it in info. dlopen() returns
+// the library it already has for a path it has seen, and a Verilated model
+// normally cannot be unloaded (it has GNU unique symbols), so every load goes
+// through a fresh copy of the file. Libraries replaced by a reload stay mapped.
+bool load_model(const string& path, BoardInfo& info, string& error) {
+    const char* tmpdir = getenv("TMPDIR");
+    string copy = string(tmpdir && *tmpdir ? tmpdir : "/tmp") + "/vga_model_XXXXXX";
+    int fd = mkstemp(&copy[0]);
+    if (fd < 0) {
+        error = "cannot create a temporary copy of " + path;
+        return false;
+    }
+    close(fd);
+    {
+        ifstream in(path, ios::binary);
+        ofstream out(copy, ios::binary | ios::trunc);
+        if (!in.is_open() || !(out << in.rdbuf())) {
+            unlink(copy.c_str());
+            error = "cannot read " + path;
+            return false;
+        }
+    }
+    void* handle = dlopen(copy.c_str(), RTLD_NOW | RTLD_LOCAL);
+    unlink(copy.c_str());   // the mapping outlives the file
+    if (!handle) {
+        error = path + ": " + dlerror();
+        return false;
+    }
+    vga_model_entry_fn entry = reinterpret_cast<vga_model_entry_fn>(dlsym(handle, VGA_MODEL_ENTRY));
+    const vga_model_api* api = entry ? entry() : nullptr;
+    if (!api || api->abi_version != VGA_MODEL_ABI_VERSION) {
+        dlclose(handle);
+        error = path + " is not a model plugin of ABI version " + to_string(VGA_MODEL_ABI_VERSION);
+        return false;
+    }
+    model_api = api;
+    info.create = &PluginBoard::create;
+    info.decode = api->decode;
+    info.savable = api->savable != 0;
+    return true;
+}
+
+// BoardInfo::reload, for 'm'
+bool reload_model(BoardInfo& info, string& error) {
+    if (!rebuild_command.empty()) {
+        cout << "rebuilding the model: " << rebuild_command << endl;
+        if (system(rebuild_command.c_str()) != 0) {
+            error = "rebuild failed";
+            return false;
+        }
+    }
+    return load_model(model_path, info, error);
+}
+
+int main(int argc, char** argv) {
+    // --model=<file>         model plugin to run
+    // --rebuild=<command>    shell command 'm' runs before loading the model again
+    // other options are those of the simulator (vga_harness.cpp)
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--model=", 8) == 0) {
+            model_path = argv[i] + 8;
+        } else if (strncmp(argv[i], "--rebuild=", 10) == 0) {
+            rebuild_command = argv[i] + 10;
+        }
+    }
+    if (model_path.empty()) {
+        cerr << "usage: " << argv[0] << " --model=<VDevelopmentBoard.so> [--rebuild=<command>] [options...]" << endl;
+        return 1;
+    }
+
+    BoardInfo info;
+    info.reload = &reload_model;
+    string error;
+    if (!load_model(model_path, info, error)) {
+        cerr << "Error: " << error << endl;
+        return 1;
+    }
+    return simulator_main(argc, argv, info);
+}